@@ -27,25 +27,28 @@ template<class IS>
 typename inserter<IS>::result normal_inserter<IS>::operator()(const tsp_graph& g, const path& old_path, int request) const {
     bool overall_success = false;
     double best_score = std::numeric_limits<double>::lowest();
-    path best_path;
+    path best_path, new_path;
+    
+    // Candidates are built into new_path: when one is the best so far, the two buffers are swapped rather than copied
+    best_path.path_v.reserve(old_path.length() + 2); best_path.load_v.reserve(old_path.length() + 2);
+    new_path.path_v.reserve(old_path.length() + 2); new_path.load_v.reserve(old_path.length() + 2);
     
     for(auto orig_position = 1u; orig_position < old_path.length(); ++orig_position) {
         for(auto dest_position = orig_position; dest_position < old_path.length(); ++dest_position) {
             bool success;
             double new_score;
-            path new_path;
             
-            std::tie(success, new_score, new_path) = this->ins_scorer(g, old_path, request, orig_position, dest_position);
+            std::tie(success, new_score) = this->ins_scorer(g, old_path, request, orig_position, dest_position, new_path);
             
             if(success && new_score > best_score) {                
                 best_score = new_score;
-                best_path = new_path;
+                std::swap(best_path, new_path);
                 overall_success = true;
             }
         }
     }
     
-    return std::make_tuple(overall_success, best_score, best_path);
+    return std::make_tuple(overall_success, best_score, std::move(best_path));
 }
 
 template<class IS>
@@ -58,19 +61,22 @@ template<class IS>
 typename inserter<IS>::result max_regret_inserter<IS>::operator()(const tsp_graph& g, const path& old_path, int request) const {
     bool overall_success = false;
     double best_score = std::numeric_limits<double>::lowest(), second_best_score = std::numeric_limits<double>::lowest();
-    path best_path, second_best_path;
+    path best_path, second_best_path, new_path;
+    
+    best_path.path_v.reserve(old_path.length() + 2); best_path.load_v.reserve(old_path.length() + 2);
+    second_best_path.path_v.reserve(old_path.length() + 2); second_best_path.load_v.reserve(old_path.length() + 2);
+    new_path.path_v.reserve(old_path.length() + 2); new_path.load_v.reserve(old_path.length() + 2);
     
     for(auto orig_position = 1u; orig_position < old_path.length(); ++orig_position) {
         for(auto dest_position = orig_position; dest_position < old_path.length(); ++dest_position) {
             bool success;
             double new_score;
-            path new_path;
             
-            std::tie(success, new_score, new_path) = this->ins_scorer(g, old_path, request, orig_position, dest_position);
+            std::tie(success, new_score) = this->ins_scorer(g, old_path, request, orig_position, dest_position, new_path);
             
             if(success && new_score > second_best_score) {
                 second_best_score = new_score;
-                second_best_path = new_path;
+                std::swap(second_best_path, new_path);
                 overall_success = true;
                 
                 if(second_best_score > best_score) {
@@ -83,11 +89,11 @@ typename inserter<IS>::result max_regret_inserter<IS>::operator()(const tsp_grap
     
     if(overall_success) {
         if(second_best_score > std::numeric_limits<double>::lowest()) {
-            return std::make_tuple(overall_success, best_score - second_best_score, best_path);
+            return std::make_tuple(overall_success, best_score - second_best_score, std::move(best_path));
         }
     }
     
-    return std::make_tuple(overall_success, best_score, best_path);
+    return std::make_tuple(overall_success, best_score, std::move(best_path));
 }
 
 #endif
\ No newline at end of file
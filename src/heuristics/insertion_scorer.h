@@ -8,18 +8,19 @@
 
 template<class PS>
 struct insertion_scorer {
-    using result = std::tuple<bool, double, path>;
+    using result = std::tuple<bool, double>;
     
     const PS& p_scorer;
     
     insertion_scorer(const PS& p_scorer) : p_scorer(p_scorer) {}
     
     // Place request i with origin in position x and destination in position y
-    result operator()(const tsp_graph& g, const path& p, int i, int x, int y) const;
+    // The new path is written into np, whose storage gets reused if it is large enough
+    result operator()(const tsp_graph& g, const path& p, int i, int x, int y, path& np) const;
 };
 
 template<class PS>
-typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp_graph& g, const path& p, int i, int x, int y) const {
+typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp_graph& g, const path& p, int i, int x, int y, path& np) const {
     assert(x <= y && y <= (int)p.length());
     
     auto n = g.g[graph_bundle].n;
@@ -34,9 +35,8 @@ typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp
         new_cost += -std::max(g.cost[p.path_v[x-1]][p.path_v[x]], 0) - std::max(g.cost[p.path_v[y-1]][p.path_v[y]], 0) + g.cost[p.path_v[x-1]][i] + g.cost[i][p.path_v[x]] + g.cost[p.path_v[y-1]][n+i] + g.cost[n+i][p.path_v[y]];
     }
     
-    path np;
-    np.path_v = std::vector<int>(p.path_v.size() + 2, 0);
-    np.load_v = std::vector<int>(p.load_v.size() + 2, 0);
+    np.path_v.resize(p.path_v.size() + 2);
+    np.load_v.resize(p.load_v.size() + 2);
     np.total_cost = new_cost;
     np.total_load = new_load;
     
@@ -50,14 +50,14 @@ typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp
 
     if(x == y) {
         if(np.load_v[x] > std::min({g.draught[i], g.draught[n+i], Q})) {
-            return std::make_tuple(false, score, np);
+            return std::make_tuple(false, score);
         }
     
         np.path_v[x+1] = n+i;
         np.load_v[x+1] = np.load_v[x] + g.demand[n+i];
     
         if(np.load_v[x] > std::min({g.draught[n+i], g.draught[p.path_v[x]], Q})) {
-            return std::make_tuple(false, score, np);
+            return std::make_tuple(false, score);
         }
     
         for(auto j = x + 2; j < (int)p.path_v.size() + 2; j++) {
@@ -66,12 +66,12 @@ typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp
         
             auto next_port_draught = (j <= (int)p.path_v.size() ? g.draught[p.path_v[j-1]] : std::numeric_limits<int>::max());
             if(np.load_v[j] > std::min({g.draught[np.path_v[j]], next_port_draught, Q})) {
-                return std::make_tuple(false, score, np);
+                return std::make_tuple(false, score);
             }
         }
     } else {
         if(np.load_v[x] > std::min({g.draught[i], g.draught[p.path_v[x]], Q})) {
-            return std::make_tuple(false, score, np);
+            return std::make_tuple(false, score);
         }
     
         for(auto j = x + 1; j <= y; j++) {
@@ -80,7 +80,7 @@ typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp
     
             auto next_port_draught = (j < y ? g.draught[p.path_v[j]] : g.draught[n+i]);
             if(np.load_v[j] > std::min({g.draught[np.path_v[j]], next_port_draught, Q})) {
-                return std::make_tuple(false, score, np);
+                return std::make_tuple(false, score);
             }
         }
 
@@ -88,7 +88,7 @@ typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp
         np.load_v[y+1] = np.load_v[y] + g.demand[n+i];
 
         if(np.load_v[y+1] > std::min({g.draught[n+i], g.draught[p.path_v[y]], Q})) {
-            return std::make_tuple(false, score, np);
+            return std::make_tuple(false, score);
         }
 
         for(auto j = y + 2; j < (int)p.path_v.size() + 2; j++) {
@@ -97,13 +97,43 @@ typename insertion_scorer<PS>::result insertion_scorer<PS>::operator()(const tsp
             
             auto next_port_draught = (j <= (int)p.path_v.size() ? g.draught[p.path_v[j-1]] : std::numeric_limits<int>::max());
             if(np.load_v[j] > std::min({g.draught[np.path_v[j]], next_port_draught, Q})) {
-                return std::make_tuple(false, score, np);
+                return std::make_tuple(false, score);
             }
         }
     }
     
-    score = p_scorer(g, np);    
-    return std::make_tuple(true, score, np);
+    // Only the arcs around the inserted nodes change capacity, while the arcs
+    // between origin and destination carry demand[i] more than before
+    auto capacity = [&g, Q] (int from, int to) { return std::min({Q, g.draught[from], g.draught[to]}); };
+    auto residual_delta = 0;
+
+    if(x == y) {
+        residual_delta = - (capacity(p.path_v[x-1], p.path_v[x]) - p.load_v[x-1])
+                         + (capacity(p.path_v[x-1], i) - p.load_v[x-1])
+                         + (capacity(i, n+i) - (p.load_v[x-1] + g.demand[i]))
+                         + (capacity(n+i, p.path_v[x]) - p.load_v[x-1]);
+    } else {
+        residual_delta = - (capacity(p.path_v[x-1], p.path_v[x]) - p.load_v[x-1])
+                         - (capacity(p.path_v[y-1], p.path_v[y]) - p.load_v[y-1])
+                         + (capacity(p.path_v[x-1], i) - p.load_v[x-1])
+                         + (capacity(i, p.path_v[x]) - (p.load_v[x-1] + g.demand[i]))
+                         - g.demand[i] * (y - 1 - x)
+                         + (capacity(p.path_v[y-1], n+i) - (p.load_v[y-1] + g.demand[i]))
+                         + (capacity(n+i, p.path_v[y]) - p.load_v[y-1]);
+    }
+
+    np.total_residual_capacity = p.total_residual_capacity + residual_delta;
+    
+    // The broken arcs leave the hash and the new ones enter it
+    if(x == y) {
+        np.hash = p.hash ^ g.arc_hash[p.path_v[x-1]][p.path_v[x]] ^ g.arc_hash[p.path_v[x-1]][i] ^ g.arc_hash[i][n+i] ^ g.arc_hash[n+i][p.path_v[x]];
+    } else {
+        np.hash = p.hash ^ g.arc_hash[p.path_v[x-1]][p.path_v[x]] ^ g.arc_hash[p.path_v[y-1]][p.path_v[y]] ^
+                  g.arc_hash[p.path_v[x-1]][i] ^ g.arc_hash[i][p.path_v[x]] ^ g.arc_hash[p.path_v[y-1]][n+i] ^ g.arc_hash[n+i][p.path_v[y]];
+    }
+
+    score = p_scorer(g, np);
+    return std::make_tuple(true, score);
 }
 
 #endif
\ No newline at end of file
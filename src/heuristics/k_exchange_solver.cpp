@@ -0,0 +1,153 @@
+#include <heuristics/k_exchange_solver.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// (2k-1) C(2k-2, k-1): offsets times sets of k-1 placed positions out of 2k-2
+long k_exchange_solver::states_per_stage(int k) {
+    auto n_masks = 1l;
+    
+    for(auto i = 1; i <= k - 1; i++) {
+        n_masks = n_masks * (k - 1 + i) / i;
+    }
+    
+    return n_masks * (2 * k - 1);
+}
+
+path k_exchange_solver::solve(const path& p, int k) const {
+    auto n = g.g[graph_bundle].n;
+    auto Q = g.g[graph_bundle].capacity;
+    auto size = (int)p.path_v.size();
+    
+    k = std::min(k, max_k);
+    
+    while(k > 2 && size * states_per_stage(k) > max_predecessor_bytes) {
+        k--;
+    }
+    
+    if(k < 2 || size != 2 * n + 2) {
+        return p;
+    }
+    
+    // At stage s the first s positions of the new tour are filled. Every position of the
+    // reference tour before b(s) = s-k+1 is already placed, and none after s+k-2 is:
+    // a state keeps which of the 2k-2 positions from b(s) are placed (always k-1 of them)
+    // and the offset from b(s)-1 of the last placed one (between 0 and 2k-2).
+    auto mask_bits = 2 * k - 2;
+    auto n_offsets = 2 * k - 1;
+    auto masks = std::vector<int>();
+    auto mask_index = std::vector<int>(1 << mask_bits, -1);
+    
+    for(auto mask = 0; mask < (1 << mask_bits); mask++) {
+        if(__builtin_popcount(mask) == k - 1) {
+            mask_index[mask] = masks.size();
+            masks.push_back(mask);
+        }
+    }
+    
+    auto n_states = (int)masks.size() * n_offsets;
+    auto state = [n_offsets, &mask_index] (int mask, int offset) { return mask_index[mask] * n_offsets + offset; };
+    
+    auto position = std::vector<int>(2 * n + 2, 0);
+    auto prefix_demand = std::vector<int>(size + 1, 0);
+    
+    for(auto l = 0; l < size; l++) {
+        position[p.path_v[l]] = l;
+        prefix_demand[l + 1] = prefix_demand[l] + g.demand[p.path_v[l]];
+    }
+    
+    auto unreachable = std::numeric_limits<int>::max();
+    auto stage_cost = std::vector<int>(n_states, unreachable);
+    auto next_stage_cost = std::vector<int>(n_states, unreachable);
+    
+    // Only the offset of the predecessor is stored: its set of placed positions follows from the
+    // state it leads to (see the walk back below)
+    auto predecessor_offset = std::vector<std::uint8_t>(size * n_states, 0);
+    
+    // Stage 1: only the start depot is placed, and positions before 0 count as placed
+    auto depot_mask = (1 << (k - 1)) - 1;
+    stage_cost[state(depot_mask, k - 1)] = 0;
+    
+    for(auto s = 1; s < size; s++) {
+        auto b = s - k + 1;
+        
+        std::fill(next_stage_cost.begin(), next_stage_cost.end(), unreachable);
+        
+        for(auto mask : masks) {
+            auto load = prefix_demand[std::max(b, 0)];
+            
+            for(auto t = 0; t < mask_bits; t++) {
+                if((mask & (1 << t)) && b + t >= 0 && b + t < size) {
+                    load += g.demand[p.path_v[b + t]];
+                }
+            }
+            
+            for(auto offset = 0; offset < n_offsets; offset++) {
+                auto current = state(mask, offset);
+                
+                if(stage_cost[current] == unreachable) {
+                    continue;
+                }
+                
+                auto u = p.path_v[b - 1 + offset];
+                
+                for(auto t = 0; t <= mask_bits; t++) {
+                    auto j = b + t;
+                    
+                    // Position b must be placed by the end of this stage
+                    if(j < 0 || j >= size || (mask & (1 << t)) || (t > 0 && !(mask & 1))) {
+                        continue;
+                    }
+                    
+                    auto v = p.path_v[j];
+                    
+                    if(g.cost[u][v] < 0 || load > std::min({Q, g.draught[u], g.draught[v]})) {
+                        continue;
+                    }
+                    
+                    if(v > n && v <= 2 * n) {
+                        auto origin_t = position[v - n] - b;
+                        
+                        if(origin_t >= mask_bits || (origin_t >= 0 && !(mask & (1 << origin_t)))) {
+                            continue;
+                        }
+                    }
+                    
+                    auto next = state((mask | (1 << t)) >> 1, t);
+                    auto next_cost = stage_cost[current] + g.cost[u][v];
+                    
+                    if(next_cost < next_stage_cost[next]) {
+                        next_stage_cost[next] = next_cost;
+                        predecessor_offset[s * n_states + next] = offset;
+                    }
+                }
+            }
+        }
+        
+        std::swap(stage_cost, next_stage_cost);
+    }
+    
+    auto final_state = state(depot_mask, k - 1);
+    
+    if(stage_cost[final_state] == unreachable || stage_cost[final_state] >= p.total_cost) {
+        return p;
+    }
+    
+    // Walk the predecessors back: the offset t of a state at stage s identifies the node in position s-1.
+    // Its mask was obtained as (mask | 1 << t) >> 1, with bit 0 set before the shift, which gives back the previous mask
+    auto nodes = std::vector<int>(size, 0);
+    auto current = final_state;
+    
+    for(auto s = size - 1; s >= 1; s--) {
+        auto t = current % n_offsets;
+        auto previous_mask = ((masks[current / n_offsets] << 1) | 1) & ~(1 << t);
+        
+        nodes[s] = p.path_v[s - k + 1 + t];
+        current = state(previous_mask, predecessor_offset[s * n_states + current]);
+    }
+    
+    nodes[0] = p.path_v[0];
+    
+    return path(g, nodes);
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef K_EXCHANGE_SOLVER_H
+#define K_EXCHANGE_SOLVER_H
+
+#include <network/tsp_graph.h>
+#include <network/path.h>
+
+#include <vector>
+
+// Balas-Simonetti-style neighbourhood: best tour in which every node is moved by
+// less than k positions with respect to the reference tour. This contains the tours
+// where the node at position i still precedes the node at position j whenever i + k <= j.
+// The dynamic program has a state for each stage, set of placed nodes among the
+// 2k-2 positions around the stage, and last placed node; the set of placed nodes
+// also fixes the load, which is how draught and capacity limits are enforced.
+// It runs in O(N k^2 C(2k-2, k-1)) where N = 2n+2, without any MIP solver.
+class k_exchange_solver {
+    const tsp_graph&    g;
+    
+    // The number of states grows as 4^k: beyond this window the memory is not worth it
+    static constexpr int max_k = 8;
+    
+    // The predecessor table takes one byte per stage and state, i.e. (2n+2) (2k-1) C(2k-2, k-1) bytes.
+    // k is lowered until the table fits: at n = 500 this allows k = 7 (12 MB), while k = 8 would take 52 MB
+    static constexpr long max_predecessor_bytes = 32l << 20;
+    
+    static long states_per_stage(int k);
+    
+public:
+    k_exchange_solver(const tsp_graph& g) : g{g} {}
+    path solve(const path& p, int k) const;
+};
+
+#endif
\ No newline at end of file
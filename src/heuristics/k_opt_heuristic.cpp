@@ -1,17 +1,114 @@
 #include <heuristics/k_opt_heuristic.h>
-#include <solver/bc/bc_solver.h>
+#include <solver/bc/k_opt_solver.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <thread>
+
+// Each MIP call has its own time and node limits. After an improvement the search restarts from
+// the new tour with a larger k; after a call stopped by the limits without improving, it retries
+// with a smaller k. It stops when a call proves that the tour is optimal for its neighbourhood.
+path k_opt_heuristic::improve(k_opt_solver& ksolv, path solution, program_data& solver_data) const {
+    using namespace std::chrono;
+    
+    auto current_k = std::min(k, params.ko.max_k);
+    
+    while(true) {
+        auto t_start = high_resolution_clock::now();
+        auto res = ksolv.solve(solution, current_k, params.ko.time_limit, params.ko.node_limit);
+        auto t_end = high_resolution_clock::now();
+        auto time_span = duration_cast<duration<double>>(t_end - t_start);
+        
+        solver_data.k_opt_calls++;
+        
+        if(res.hit_limit) {
+            solver_data.k_opt_calls_at_limit++;
+        }
+        
+        if(res.p.path_v.size() > 0 && res.p.total_cost < solution.total_cost) {
+            solver_data.k_opt_improving_calls++;
+            solver_data.time_spent_by_improving_k_opt_calls += time_span.count();
+            
+            solution = std::move(res.p);
+            current_k = std::min(current_k + 1, params.ko.max_k);
+        } else if(res.hit_limit && current_k > min_k) {
+            current_k--;
+        } else {
+            break;
+        }
+    }
+    
+    return solution;
+}
 
 std::vector<path> k_opt_heuristic::solve() const {
-    auto n = g.g[graph_bundle].n;
+    using namespace std::chrono;
+    
+    if(initial_solutions.empty()) {
+        return std::vector<path>();
+    }
+    
+    // The solvers share the cplex_threads budget: each gets at least one thread, so there are no more solvers than threads
+    auto n_solvers = std::max(1, std::min({params.ko.max_parallel_solvers, params.cplex_threads, (int)initial_solutions.size()}));
+    auto threads_per_solver = std::max(1, params.cplex_threads / n_solvers);
+    auto results = std::vector<path>(initial_solutions.size());
+    auto errors = std::vector<std::exception_ptr>(n_solvers);
+    auto solvers_data = std::vector<program_data>(n_solvers);
+    std::atomic<int> next_solution(0);
+    auto solvers = std::vector<std::thread>();
+    
+    auto t_start = high_resolution_clock::now();
+    
+    // Each solver owns its CPLEX environment, a copy of the graph and its own program_data,
+    // as the cut separators write into both. Its model is built once and reused for every tour it takes.
+    for(auto s = 0; s < n_solvers; s++) {
+        solvers.push_back(std::thread(
+            [this, s, threads_per_solver, &results, &errors, &solvers_data, &next_solution] () {
+                try {
+                    auto solver_g = g;
+                    k_opt_solver ksolv(solver_g, params, solvers_data[s], threads_per_solver);
+                    
+                    for(auto sol_n = next_solution++; sol_n < (int)initial_solutions.size(); sol_n = next_solution++) {
+                        if(initial_solutions[sol_n].path_v.size() > 0) {
+                            results[sol_n] = improve(ksolv, initial_solutions[sol_n], solvers_data[s]);
+                        }
+                    }
+                } catch(...) {
+                    errors[s] = std::current_exception();
+                }
+            }
+        ));
+    }
+    
+    for(auto& t : solvers) {
+        t.join();
+    }
+    
+    auto t_end = high_resolution_clock::now();
+    auto time_span = duration_cast<duration<double>>(t_end - t_start);
+    data.time_spent_by_k_opt_heuristics += time_span.count();
+    
+    for(const auto& solver_data : solvers_data) {
+        data.k_opt_calls += solver_data.k_opt_calls;
+        data.k_opt_improving_calls += solver_data.k_opt_improving_calls;
+        data.k_opt_calls_at_limit += solver_data.k_opt_calls_at_limit;
+        data.time_spent_by_improving_k_opt_calls += solver_data.time_spent_by_improving_k_opt_calls;
+    }
+    
+    for(const auto& error : errors) {
+        if(error) {
+            std::rethrow_exception(error);
+        }
+    }
+    
+    // Results keep the order of the starting tours
     auto paths = std::vector<path>();
     
-    for(const auto& solution : initial_solutions) {
-        if(solution.path_v.size() > 0) {
-            auto sol_x = solution.get_x_values(n);
-            auto msolv = bc_solver(g, params, data, initial_solutions);
-            auto p = msolv.solve_for_k_opt(solution, sol_x, (2 * n) + 1 - k);
-        
-            paths.push_back(p);
+    for(auto sol_n = 0u; sol_n < initial_solutions.size(); sol_n++) {
+        if(initial_solutions[sol_n].path_v.size() > 0) {
+            paths.push_back(std::move(results[sol_n]));
         }
     }
     
@@ -8,6 +8,8 @@
 
 #include <vector>
 
+class k_opt_solver;
+
 class k_opt_heuristic {
     tsp_graph&              g;
     const program_params&   params;
@@ -15,6 +17,10 @@ class k_opt_heuristic {
     int                     k;
     std::vector<path>       initial_solutions;
     
+    static constexpr int min_k = 2;
+    
+    path improve(k_opt_solver& ksolv, path solution, program_data& solver_data) const;
+    
 public:
     k_opt_heuristic(tsp_graph& g, const program_params& params, program_data& data, int k, const std::vector<path>& initial_solutions) : g{g}, params{params}, data{data}, k{k}, initial_solutions{initial_solutions} {}
     std::vector<path> solve() const;
@@ -7,6 +7,7 @@
 #include <vector>
 #include <algorithm>
 #include <limits>
+#include <numeric>
 
 #include <boost/optional.hpp>
 
@@ -17,6 +18,9 @@ struct one_phase_heuristic {
     
     one_phase_heuristic(const tsp_graph& g, const I& ins) : g(g), ins(ins) {}
     boost::optional<path> solve() const;
+    
+    // Insert the requests in R into the partial path p
+    boost::optional<path> solve(path p, std::vector<int> R) const;
 };
 
 template<class I>
@@ -28,15 +32,24 @@ boost::optional<path> one_phase_heuristic<I>::solve() const {
     p.path_v.reserve(2 * n + 2); p.load_v.reserve(2 * n + 2);
     p.path_v.push_back(0); p.path_v.push_back(2*n+1);
     p.load_v.push_back(0); p.load_v.push_back(0);
+    p.total_residual_capacity = p.compute_residual_capacity(this->g);
+    p.hash = p.compute_hash(this->g);
     
     // Fill the requests vector
     std::iota(R.begin(), R.end(), 1);
     
+    return solve(std::move(p), std::move(R));
+}
+
+template<class I>
+boost::optional<path> one_phase_heuristic<I>::solve(path p, std::vector<int> R) const {
     while(!R.empty()) {
         // Score of the best insertion of the best request
         double best_score = std::numeric_limits<double>::lowest();
         // Best new path (the one where the best insertion of the best request is performed, starting from p)
         path best_path;
+        // Path returned by the inserter for the current request
+        path new_path;
         // Insertion corresponding to the best_path
         int best_insertion;
         // Did we manage to insert something at this round?
@@ -46,13 +59,12 @@ boost::optional<path> one_phase_heuristic<I>::solve() const {
         for(auto i : R) {
             bool success;
             double new_score;
-            path new_path;
             
             std::tie(success, new_score, new_path) = this->ins(this->g, p, i);
             
             if(success && new_score > best_score) {
                 best_score = new_score;
-                best_path = new_path;
+                std::swap(best_path, new_path);
                 best_insertion = i;
                 round_success = true;
             }
@@ -63,7 +75,7 @@ boost::optional<path> one_phase_heuristic<I>::solve() const {
         }
         
         // Update the current path p
-        p = best_path;
+        p = std::move(best_path);
         
         // Remove best_insertion from R
         R.erase(std::remove(R.begin(), R.end(), best_insertion), R.end());
@@ -0,0 +1,276 @@
+#include <heuristics/savings_heuristic.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+int savings_heuristic::capacity(int from, int to) const {
+    return std::min({g.g[graph_bundle].capacity, g.draught[from], g.draught[to]});
+}
+
+// Check that the chain i -> n+i is feasible on its own. The depot arcs are only needed by the
+// two ends of the final chain, and are checked there
+bool savings_heuristic::can_serve_alone(int request) const {
+    auto n = g.g[graph_bundle].n;
+    
+    if(g.cost[request][n + request] < 0) {
+        return false;
+    }
+    
+    return (g.demand[request] <= capacity(request, n + request));
+}
+
+int savings_heuristic::max_cost() const {
+    auto n = g.g[graph_bundle].n;
+    auto max_cost = 0;
+    
+    for(auto i = 0; i <= 2 * n + 1; i++) {
+        for(auto j = 0; j <= 2 * n + 1; j++) {
+            max_cost = std::max(max_cost, g.cost[i][j]);
+        }
+    }
+    
+    return max_cost;
+}
+
+boost::optional<path> savings_heuristic::solve() const {
+    auto p_nodes = merge_nodes();
+    auto p_requests = merge_requests();
+    
+    if(!p_nodes || (p_requests && p_requests->total_cost < p_nodes->total_cost)) {
+        return p_requests;
+    }
+    
+    return p_nodes;
+}
+
+boost::optional<path> savings_heuristic::merge_nodes() const {
+    auto n = g.g[graph_bundle].n;
+    auto no_node = -1;
+    
+    // Chains are linked lists of nodes, joined in a union-find forest. The root of each tree keeps
+    // the head and the tail of its chain, the load the chain leaves open, and the least slack of
+    // its arcs for a chain entered with the ship empty
+    auto next_node = std::vector<int>(2 * n + 2, no_node);
+    auto prev_node = std::vector<int>(2 * n + 2, no_node);
+    auto parent = std::vector<int>(2 * n + 2);
+    auto chain_head = std::vector<int>(2 * n + 2);
+    auto chain_tail = std::vector<int>(2 * n + 2);
+    auto open_load = std::vector<int>(2 * n + 2, 0);
+    auto min_slack = std::vector<int>(2 * n + 2, std::numeric_limits<int>::max());
+    auto in_chain = std::vector<bool>(2 * n + 2, false);
+    
+    std::iota(parent.begin(), parent.end(), 0);
+    std::iota(chain_head.begin(), chain_head.end(), 0);
+    std::iota(chain_tail.begin(), chain_tail.end(), 0);
+    
+    for(auto i = 1; i <= n; i++) {
+        open_load[i] = g.demand[i];
+        in_chain[i] = true;
+    }
+    
+    auto root = [&parent] (int node) {
+        while(parent[node] != node) {
+            parent[node] = parent[parent[node]];
+            node = parent[node];
+        }
+        
+        return node;
+    };
+    
+    // The ship starts and ends at the depot: an origin can't close the tour and a destination
+    // can't open it, so the saving uses whichever of the two depot arcs the node has
+    auto expensive = max_cost();
+    auto depot_cost = [this, n, expensive] (int node) {
+        if(g.cost[0][node] >= 0) { return g.cost[0][node]; }
+        if(g.cost[node][2 * n + 1] >= 0) { return g.cost[node][2 * n + 1]; }
+        return expensive;
+    };
+    
+    // Saving obtained by going directly from u to v, rather than passing through the depot
+    auto savings = std::vector<saving>();
+    savings.reserve(4 * n * n);
+    
+    for(auto u = 1; u <= 2 * n; u++) {
+        for(auto v = 1; v <= 2 * n; v++) {
+            if(u != v && u != n + v && g.cost[u][v] >= 0) {
+                savings.push_back(saving(depot_cost(u) + depot_cost(v) - g.cost[u][v], u, v));
+            }
+        }
+    }
+    
+    std::sort(savings.begin(), savings.end(), [] (const saving& s1, const saving& s2) { return s2 < s1; });
+    
+    auto merges = 0;
+    auto merges_before_pass = -1;
+    
+    while(merges < 2 * n - 1 && merges > merges_before_pass) {
+        merges_before_pass = merges;
+        
+        for(const auto& s : savings) {
+            auto u = s.from;
+            auto v = s.to;
+            
+            // u must close its chain
+            if(!in_chain[u] || next_node[u] != no_node) {
+                continue;
+            }
+            
+            auto a = root(u);
+            auto load = open_load[a];
+            
+            if(capacity(u, v) < load) {
+                continue;
+            }
+            
+            if(v <= n) {
+                // An origin must open another chain, whose arcs all get the load left open by u's
+                auto b = root(v);
+                
+                // The load left open by the merged chain must also fit the ship at its tail
+                if(prev_node[v] != no_node || b == a || min_slack[b] < load || load + open_load[b] > capacity(chain_tail[b], chain_tail[b])) {
+                    continue;
+                }
+                
+                min_slack[a] = std::min({min_slack[a], capacity(u, v) - load, min_slack[b] - load});
+                open_load[a] += open_load[b];
+                chain_tail[a] = chain_tail[b];
+                parent[b] = a;
+            } else {
+                // A destination joins the chain of its origin
+                if(in_chain[v] || root(v - n) != a) {
+                    continue;
+                }
+                
+                min_slack[a] = std::min(min_slack[a], capacity(u, v) - load);
+                open_load[a] += g.demand[v];
+                chain_tail[a] = v;
+                parent[v] = a;
+                in_chain[v] = true;
+            }
+            
+            next_node[u] = v;
+            prev_node[v] = u;
+            merges++;
+        }
+    }
+    
+    if(merges < 2 * n - 1) {
+        return boost::none;
+    }
+    
+    auto a = root(1);
+    auto first_node = chain_head[a];
+    auto last_node = chain_tail[a];
+    
+    if(g.cost[0][first_node] < 0 || g.cost[last_node][2 * n + 1] < 0) {
+        return boost::none;
+    }
+    
+    auto nodes = std::vector<int>();
+    nodes.reserve(2 * n + 2);
+    nodes.push_back(0);
+    
+    for(auto i = first_node; i != no_node; i = next_node[i]) {
+        nodes.push_back(i);
+    }
+    
+    nodes.push_back(2 * n + 1);
+    
+    return path(g, nodes);
+}
+
+boost::optional<path> savings_heuristic::merge_requests() const {
+    auto n = g.g[graph_bundle].n;
+    
+    for(auto i = 1; i <= n; i++) {
+        if(!can_serve_alone(i)) {
+            return boost::none;
+        }
+    }
+    
+    // Chains are doubly linked lists of requests; a chain head knows its tail and vice versa
+    auto next_request = std::vector<int>(n + 1, 0);
+    auto prev_request = std::vector<int>(n + 1, 0);
+    auto chain_tail = std::vector<int>(n + 1, 0);
+    auto chain_head = std::vector<int>(n + 1, 0);
+    
+    std::iota(chain_tail.begin(), chain_tail.end(), 0);
+    std::iota(chain_head.begin(), chain_head.end(), 0);
+    
+    // A missing depot arc counts as the most expensive arc, so that the chains which can't
+    // open or close the tour are merged first
+    auto expensive = max_cost();
+    auto depot_cost = [this, expensive] (int i, int j) { return (g.cost[i][j] >= 0 ? g.cost[i][j] : expensive); };
+    
+    // Saving obtained by going directly from n+i to j, rather than passing through the depot
+    auto savings = std::vector<saving>();
+    savings.reserve(n * (n - 1));
+    
+    for(auto i = 1; i <= n; i++) {
+        for(auto j = 1; j <= n; j++) {
+            if(i != j && g.cost[n + i][j] >= 0) {
+                savings.push_back(saving(depot_cost(n + i, 2 * n + 1) + depot_cost(0, j) - g.cost[n + i][j], i, j));
+            }
+        }
+    }
+    
+    auto heap = std::priority_queue<saving>(std::less<saving>(), std::move(savings));
+    auto merges = 0;
+    
+    while(!heap.empty() && merges < n - 1) {
+        auto s = heap.top();
+        heap.pop();
+        
+        auto i = s.from;
+        auto j = s.to;
+        
+        // i must close its chain, j must open another one
+        if(next_request[i] != 0 || prev_request[j] != 0 || chain_head[i] == j) {
+            continue;
+        }
+        
+        // Chains only ever contain whole requests, so the ship is empty at the junction:
+        // precedence, load and draught feasibility of the merged chain follow from those of its
+        // two parts, which are feasible by construction. The linking arc exists, or it would not
+        // have a saving associated.
+        auto head = chain_head[i];
+        auto tail = chain_tail[j];
+        
+        next_request[i] = j;
+        prev_request[j] = i;
+        chain_tail[head] = tail;
+        chain_head[tail] = head;
+        
+        merges++;
+    }
+    
+    if(merges < n - 1) {
+        return boost::none;
+    }
+    
+    auto first_request = 1;
+    while(prev_request[first_request] != 0) {
+        first_request = prev_request[first_request];
+    }
+    
+    auto last_request = chain_tail[first_request];
+    
+    if(g.cost[0][first_request] < 0 || g.cost[n + last_request][2 * n + 1] < 0) {
+        return boost::none;
+    }
+    
+    auto nodes = std::vector<int>();
+    nodes.reserve(2 * n + 2);
+    nodes.push_back(0);
+    
+    for(auto i = first_request; i != 0; i = next_request[i]) {
+        nodes.push_back(i);
+        nodes.push_back(n + i);
+    }
+    
+    nodes.push_back(2 * n + 1);
+    
+    return path(g, nodes);
+}
@@ -0,0 +1,50 @@
+#ifndef SAVINGS_HEURISTIC_H
+#define SAVINGS_HEURISTIC_H
+
+#include <network/tsp_graph.h>
+#include <network/path.h>
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+// Clarke-Wright savings adapted to pickup and delivery pairs. Chains of nodes are linked
+// greedily, following the savings of the linking arcs in non-increasing order. solve() runs
+// both constructions below and returns the cheaper tour:
+// - merge_nodes(): every origin starts as its own chain, and a destination can only be appended
+//   to the chain of its origin, so that the ship can carry several requests at once. The chains
+//   stay closed to the left (each destination comes after its origin), and each one keeps the
+//   load it leaves open and the least slack of its arcs, so that load and draught feasibility
+//   of a link is checked in O(1). It gets stuck when the open loads block every link left;
+// - merge_requests(): every request starts as its own chain (origin, destination), and the
+//   chains are concatenated with the ship empty at each junction, so that requests are never
+//   interleaved. It is usually cheaper on the instances with few requests.
+// Sorting the savings takes O(n^2 log n); merge_nodes() then passes again over them, in O(n^2),
+// as long as the previous pass linked some chains.
+class savings_heuristic {
+    const tsp_graph&    g;
+    
+    struct saving {
+        int value;
+        int from; // The tail of a chain (a node, or a request whose destination is the tail)...
+        int to;   // ...is linked to the head of another chain, or to a destination
+        
+        saving(int value, int from, int to) : value{value}, from{from}, to{to} {}
+        bool operator<(const saving& other) const { return value < other.value; }
+    };
+    
+    int capacity(int from, int to) const;
+    bool can_serve_alone(int request) const;
+    
+    // Cost of the most expensive arc, which stands for the missing depot arcs
+    int max_cost() const;
+    
+    boost::optional<path> merge_nodes() const;
+    boost::optional<path> merge_requests() const;
+
+public:
+    savings_heuristic(const tsp_graph& g) : g{g} {}
+    boost::optional<path> solve() const;
+};
+
+#endif
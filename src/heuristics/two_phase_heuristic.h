@@ -33,6 +33,8 @@ boost::optional<path> two_phase_heuristic<RS, IS>::solve() const {
     p.path_v.reserve(2 * n + 2); p.load_v.reserve(2 * n + 2);
     p.path_v.push_back(0); p.path_v.push_back(2*n+1);
     p.load_v.push_back(0); p.load_v.push_back(0);
+    p.total_residual_capacity = p.compute_residual_capacity(this->g);
+    p.hash = p.compute_hash(this->g);
     
     std::multiset<scored_request, scored_request_comparator> R;
     
@@ -53,7 +55,7 @@ boost::optional<path> two_phase_heuristic<RS, IS>::solve() const {
             return boost::none;
         }
         
-        p = new_path;
+        p = std::move(new_path);
     }
     
     return p;
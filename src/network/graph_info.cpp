@@ -5,7 +5,7 @@
 
 #include <sstream>
 
-graph_info::graph_info(int n, int capacity, std::string instance_path) : n{n}, capacity{capacity}, instance_path{instance_path} {
+graph_info::graph_info(int n, int capacity, std::string instance_path) : n{n}, capacity{capacity}, arcs_removed_by_paths{0}, instance_path{instance_path} {
     auto path_parts = std::vector<std::string>();
     boost::split(path_parts, instance_path, boost::is_any_of("/"));
     
@@ -9,6 +9,9 @@ struct graph_info {
     double k;
     int capacity;
     
+    // Arcs removed by tsp_graph::remove_arcs_on_eliminable_paths(), besides those infeasible by themselves
+    int arcs_removed_by_paths;
+    
     std::string instance_path;
     std::string instance_dir;
     std::string instance_name;
@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <stdexcept>
+#include <unordered_set>
 
 path::path(const tsp_graph& g, const std::vector<std::vector<int>>& x) {
     auto current_node = 0;
@@ -11,6 +12,7 @@ path::path(const tsp_graph& g, const std::vector<std::vector<int>>& x) {
     
     total_cost = 0;
     total_load = 0;
+    hash = 0;
     
     path_v.reserve(2 * n + 2);
     load_v.reserve(2 * n + 2);
@@ -33,6 +35,7 @@ path::path(const tsp_graph& g, const std::vector<std::vector<int>>& x) {
                 load_v.push_back(current_load);
                 if(g.demand[j] > 0) { total_load += g.demand[j]; }
                 total_cost += g.cost[current_node][j];
+                hash ^= g.arc_hash[current_node][j];
                 visited_nodes.push_back(current_node);
                 current_node = j;
                 break;
@@ -50,6 +53,23 @@ path::path(const tsp_graph& g, const std::vector<std::vector<int>>& x) {
             std::cerr << std::endl;
         }
     }
+    
+    total_residual_capacity = compute_residual_capacity(g);
+}
+
+path::path(const tsp_graph& g, const std::vector<int>& nodes) : path_v{nodes}, total_load{0}, total_cost{0}, hash{0} {
+    auto current_load = 0;
+    
+    load_v.reserve(path_v.size());
+    
+    for(auto i = 0u; i < path_v.size(); i++) {
+        current_load += g.demand[path_v[i]];
+        load_v.push_back(current_load);
+        if(g.demand[path_v[i]] > 0) { total_load += g.demand[path_v[i]]; }
+        if(i > 0) { total_cost += g.cost[path_v[i-1]][path_v[i]]; hash ^= g.arc_hash[path_v[i-1]][path_v[i]]; }
+    }
+    
+    total_residual_capacity = compute_residual_capacity(g);
 }
 
 std::vector<std::vector<int>> path::get_x_values(int n) const {
@@ -131,10 +151,99 @@ bool path::verify_feasible(const tsp_graph& g) const {
     return true;
 }
 
+// Full recomputation of total_residual_capacity. The draught of each arc is gathered first,
+// so that the accumulation runs over two contiguous arrays and gets vectorised by the compiler.
+int path::compute_residual_capacity(const tsp_graph& g) const {
+    if(path_v.size() < 2u) {
+        return 0;
+    }
+    
+    auto Q = g.g[graph_bundle].capacity;
+    auto n_arcs = path_v.size() - 1;
+    auto arc_draught = std::vector<int>(n_arcs);
+    
+    for(auto i = 0u; i < n_arcs; ++i) {
+        arc_draught[i] = std::min(g.draught[path_v[i]], g.draught[path_v[i+1]]);
+    }
+    
+    const auto* draught = arc_draught.data();
+    const auto* load = load_v.data();
+    auto residual_capacity = 0;
+    
+    for(auto i = 0u; i < n_arcs; ++i) {
+        residual_capacity += std::min(Q, draught[i]) - load[i];
+    }
+    
+    return residual_capacity;
+}
+
+std::uint64_t path::compute_hash(const tsp_graph& g) const {
+    auto h = std::uint64_t(0);
+    
+    for(auto i = 1u; i < path_v.size(); i++) {
+        h ^= g.arc_hash[path_v[i-1]][path_v[i]];
+    }
+    
+    return h;
+}
+
+// Map a tour of the instance mirrored to g (see tsp_graph::make_mirror_tsp_graph()) to a tour of g
+path path::mirror(const tsp_graph& g) const {
+    auto nodes = std::vector<int>(path_v.rbegin(), path_v.rend());
+    
+    for(auto& i : nodes) {
+        i = g.mirror_node(i);
+    }
+    
+    return path(g, nodes);
+}
+
+path path::without_requests(const tsp_graph& g, const std::vector<int>& requests) const {
+    auto n = g.g[graph_bundle].n;
+    auto nodes = std::vector<int>();
+    
+    nodes.reserve(path_v.size());
+    
+    for(auto j : path_v) {
+        auto request = (j > n && j <= 2 * n ? j - n : j);
+        
+        if(std::find(requests.begin(), requests.end(), request) == requests.end()) {
+            nodes.push_back(j);
+        }
+    }
+    
+    auto p = path(g, nodes);
+    
+    p.total_cost = 0;
+    
+    for(auto l = 0u; l < nodes.size() - 1; l++) {
+        p.total_cost += std::max(g.cost[nodes[l]][nodes[l+1]], 0);
+    }
+    
+    return p;
+}
+
+bool path::uses_removed_arcs(const tsp_graph& g) const {
+    for(auto l = 0u; l + 1 < path_v.size(); l++) {
+        if(g.cost[path_v[l]][path_v[l+1]] < 0) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
 void path::print(std::ostream& where) const {
     std::copy(path_v.begin(), path_v.end(), std::ostream_iterator<int>(where, " "));
 }
 
 bool path::operator==(const path& other) const {
-    return path_v == other.path_v;
+    return hash == other.hash && path_v == other.path_v;
+}
+
+// Two distinct tours with the same 64-bit hash are unlikely enough to be ignored
+void path::remove_duplicates(std::vector<path>& paths) {
+    auto seen = std::unordered_set<std::uint64_t>();
+    
+    paths.erase(std::remove_if(paths.begin(), paths.end(), [&seen] (const path& p) { return !seen.insert(p.hash).second; }), paths.end());
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <network/tsp_graph.h>
 
+#include <cstdint>
 #include <iostream>
 #include <vector>
 
@@ -12,18 +13,37 @@ struct path {
     int total_load;
     int total_cost;
     
+    // Sum over the arcs of min(Q, draught of both ports) - load, kept up to date by the insertion scorer
+    int total_residual_capacity;
+    
+    // Xor of the Zobrist keys of the arcs (see tsp_graph::arc_hash), kept up to date by the insertion scorer
+    std::uint64_t hash;
+    
     static constexpr double eps = 0.0001;
     
-    path() : path_v{std::vector<int>()}, load_v{std::vector<int>()}, total_load{0}, total_cost{0} {}
+    path() : path_v{std::vector<int>()}, load_v{std::vector<int>()}, total_load{0}, total_cost{0}, total_residual_capacity{0}, hash{0} {}
     path(const tsp_graph& g, const std::vector<std::vector<int>>& x);
+    path(const tsp_graph& g, const std::vector<int>& nodes);
         
     inline std::vector<int>::size_type length() const { return path_v.size(); }
     
     bool verify_feasible(const tsp_graph& g) const;
+    int compute_residual_capacity(const tsp_graph& g) const;
+    std::uint64_t compute_hash(const tsp_graph& g) const;
+    path mirror(const tsp_graph& g) const;
+    
+    // Tour without the origins and the destinations of the given requests. Arcs removed during preprocessing
+    // (cost -1) closing the gaps count as 0 in total_cost, as the insertion scorer does when it breaks them
+    path without_requests(const tsp_graph& g, const std::vector<int>& requests) const;
+    bool uses_removed_arcs(const tsp_graph& g) const;
     std::vector<std::vector<int>> get_x_values(int n) const;
     void print(std::ostream& where) const;
     
+    // Tours are compared by hash first
     bool operator==(const path& other) const;
+    
+    // Keeps the first occurrence of each tour, in the original order
+    static void remove_duplicates(std::vector<path>& paths);
 };
 
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include <network/tsp_graph.h>
 
 #include <algorithm>
+#include <random>
 
 tsp_graph::tsp_graph(const demand_t& demand, const draught_t& draught, const cost_t& cost, int capacity, std::string instance_path) : demand{demand}, draught{draught}, cost{cost} {
     assert(demand.size() % 2 == 0);
@@ -12,6 +13,16 @@ tsp_graph::tsp_graph(const demand_t& demand, const draught_t& draught, const cos
     assert((int)cost.size() == (2 * n + 2));
     
     g[graph_bundle] = graph_info(n, capacity, instance_path);
+    
+    // Fixed seed, so that a tour has the same hash in every run
+    auto key_gen = std::mt19937_64(2 * n + 2);
+    arc_hash = arc_hash_t(2 * n + 2, std::vector<std::uint64_t>(2 * n + 2));
+    
+    for(auto& row : arc_hash) {
+        for(auto& key : row) {
+            key = key_gen();
+        }
+    }
 
     auto start_depot = node(0, demand[0], draught[0]);
     auto end_depot = node(2*n+1, demand[2*n+1], draught[2*n+1]);
@@ -26,8 +37,7 @@ tsp_graph::tsp_graph(const demand_t& demand, const draught_t& draught, const cos
         auto origin_v = add_vertex(g); g[origin_v] = origin;
         auto destination_v = add_vertex(g); g[destination_v] = destination;
     }
-        
-    auto arc_id = 0;
+    
     vi_t vi, vi_end, vj, vj_end;
     
     for(std::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
@@ -44,6 +54,7 @@ tsp_graph::tsp_graph(const demand_t& demand, const draught_t& draught, const cos
             auto j = g[*vj].id;
             
             if( (*vi == *vj) ||
+                (cost[i][j] < 0) ||
                 (*vj == start_depot_v) ||
                 (*vi == start_depot_v && j > n) ||
                 (*vj == end_depot_v && i <= n) ||
@@ -71,15 +82,119 @@ tsp_graph::tsp_graph(const demand_t& demand, const draught_t& draught, const cos
             }
             
             this->cost[i][j] = cost[i][j];
-            auto new_arc = arc(arc_id++, cost[i][j]);
-            auto edge = add_edge(*vi, *vj, g).first;
-            g[edge] = new_arc;
+        }
+    }
+    
+    g[graph_bundle].arcs_removed_by_paths = remove_arcs_on_eliminable_paths();
+    
+    auto arc_id = 0;
+    
+    for(std::tie(vi, vi_end) = vertices(g); vi != vi_end; ++vi) {
+        for(std::tie(vj, vj_end) = vertices(g); vj != vj_end; ++vj) {
+            auto i = g[*vi].id;
+            auto j = g[*vj].id;
+            
+            if(this->cost[i][j] >= 0) {
+                auto new_arc = arc(arc_id++, this->cost[i][j]);
+                auto edge = add_edge(*vi, *vj, g).first;
+                g[edge] = new_arc;
+            }
         }
     }
     
     populate_list_of_infeasible_3_paths();
 }
 
+// Arc (i,j) can't be in a feasible tour if every path i -> j -> k or every path h -> i -> j is eliminable.
+// Neither can it if a node has a single arc left entering (leaving) it: every tour uses that arc, so
+// the other arcs leaving its tail (entering its head) and its reverse arc go. Each removal can make
+// other arcs removable, so the rules are applied until nothing changes. Returns the arcs removed.
+int tsp_graph::remove_arcs_on_eliminable_paths() {
+    auto n = g[graph_bundle].n;
+    auto removed = 0;
+    auto changed = true;
+    
+    auto remove = [this, &removed, &changed] (int i, int j) {
+        if(cost[i][j] >= 0) {
+            cost[i][j] = -1;
+            removed++;
+            changed = true;
+        }
+    };
+    
+    while(changed) {
+        changed = false;
+        
+        for(auto i = 1; i <= 2*n; i++) {
+            for(auto j = 1; j <= 2*n; j++) {
+                if(cost[i][j] < 0) {
+                    continue;
+                }
+                
+                // is_path_eliminable() only deals with paths between origins and destinations
+                auto all_forward_eliminable = (cost[j][2*n + 1] < 0);
+                auto all_backward_eliminable = (cost[0][i] < 0);
+                
+                for(auto k = 1; k <= 2*n && all_forward_eliminable; k++) {
+                    if(k != i && cost[j][k] >= 0 && !is_path_eliminable(i, j, k)) {
+                        all_forward_eliminable = false;
+                    }
+                }
+                
+                for(auto h = 1; h <= 2*n && all_backward_eliminable; h++) {
+                    if(h != j && cost[h][i] >= 0 && !is_path_eliminable(h, i, j)) {
+                        all_backward_eliminable = false;
+                    }
+                }
+                
+                if(all_forward_eliminable || all_backward_eliminable) {
+                    remove(i, j);
+                }
+            }
+        }
+        
+        for(auto j = 1; j <= 2*n + 1; j++) {
+            auto arcs_in = 0;
+            auto only_tail = -1;
+            
+            for(auto i = 0; i <= 2*n; i++) {
+                if(cost[i][j] >= 0) {
+                    arcs_in++;
+                    only_tail = i;
+                }
+            }
+            
+            if(arcs_in == 1) {
+                for(auto k = 1; k <= 2*n + 1; k++) {
+                    if(k != j) { remove(only_tail, k); }
+                }
+                remove(j, only_tail);
+            }
+        }
+        
+        for(auto i = 0; i <= 2*n; i++) {
+            auto arcs_out = 0;
+            auto only_head = -1;
+            
+            for(auto j = 1; j <= 2*n + 1; j++) {
+                if(cost[i][j] >= 0) {
+                    arcs_out++;
+                    only_head = j;
+                }
+            }
+            
+            if(arcs_out == 1) {
+                for(auto h = 0; h <= 2*n; h++) {
+                    if(h != i) { remove(h, only_head); }
+                }
+                remove(only_head, i);
+            }
+        }
+    }
+    
+    return removed;
+}
+
 void tsp_graph::populate_list_of_infeasible_3_paths() {
     auto n = g[graph_bundle].n;
     
@@ -165,4 +280,35 @@ tsp_graph tsp_graph::make_reverse_tsp_graph() const {
     }
     
     return gr;
+}
+
+// In the mirrored instance the tour is travelled backwards, so origins and destinations swap roles:
+// node i of the mirror corresponds to node mirror_node(i) of the original graph and vice versa
+int tsp_graph::mirror_node(int i) const {
+    auto n = g[graph_bundle].n;
+    
+    if(i == 0) { return 2 * n + 1; }
+    if(i == 2 * n + 1) { return 0; }
+    
+    return (i <= n ? n + i : i - n);
+}
+
+// Reversing a feasible tour and mapping its nodes with mirror_node() gives a feasible tour of
+// the mirrored instance, of the same cost: each arc carries the same load in the opposite direction
+tsp_graph tsp_graph::make_mirror_tsp_graph() const {
+    auto n = g[graph_bundle].n;
+    auto m_demand = demand_t(2 * n + 2, 0);
+    auto m_draught = draught_t(2 * n + 2, 0);
+    auto m_cost = cost_t(2 * n + 2, cost_row_t(2 * n + 2, -1));
+    
+    for(auto i = 0; i <= 2 * n + 1; i++) {
+        m_demand[i] = -demand[mirror_node(i)];
+        m_draught[i] = draught[mirror_node(i)];
+        
+        for(auto j = 0; j <= 2 * n + 1; j++) {
+            m_cost[i][j] = cost[mirror_node(j)][mirror_node(i)];
+        }
+    }
+    
+    return tsp_graph(m_demand, m_draught, m_cost, g[graph_bundle].capacity, g[graph_bundle].instance_path);
 }
\ No newline at end of file
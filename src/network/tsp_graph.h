@@ -9,6 +9,7 @@
 #include <boost/graph/graph_traits.hpp>
 #include <boost/graph/adjacency_list.hpp>
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -22,6 +23,7 @@ struct tsp_graph {
     using cost_val_t = int;
     using cost_row_t = std::vector<cost_val_t>;
     using cost_t = std::vector<cost_row_t>;
+    using arc_hash_t = std::vector<std::vector<std::uint64_t>>;
 
     using graph_t = adjacency_list<listS, listS, directedS, node, arc, graph_info>;
     using vertex_t = graph_traits<graph_t>::vertex_descriptor;
@@ -36,13 +38,19 @@ struct tsp_graph {
     draught_t draught;
     cost_t cost;
     
+    // Zobrist keys of the arcs: the hash of a tour is the xor of the keys of its arcs
+    arc_hash_t arc_hash;
+    
     infeasible_paths_map infeas_list;
 
     tsp_graph() {}
     tsp_graph(const demand_t& demand, const draught_t& draught, const cost_t& cost, int capacity, std::string instance_path);
     
     tsp_graph make_reverse_tsp_graph() const;
+    tsp_graph make_mirror_tsp_graph() const;
+    int mirror_node(int i) const;
     bool is_path_eliminable(int i, int j, int k) const;
+    int remove_arcs_on_eliminable_paths();
     void populate_list_of_infeasible_3_paths();
 };
 
@@ -0,0 +1,41 @@
+#ifndef ALNS_PARAMS_H
+#define ALNS_PARAMS_H
+
+#include <string>
+
+struct alns_params {
+    double      time_limit;             // Wall-clock budget, in seconds
+    int         max_iter;
+    int         min_removed_requests;   // Requests taken out by a destroy operator, at least...
+    double      max_removed_fraction;   // ...and at most this fraction of all requests
+    int         segment_length;         // Iterations between two updates of the operator weights
+    double      reaction_factor;        // How much the weights follow the scores of the last segment
+    double      start_temperature;      // A tour this much worse than the start is first accepted with probability 1/2
+    double      cooling_rate;           // The temperature is multiplied by this at each iteration
+    unsigned    seed;                   // Of the random choices, so that runs can be reproduced
+    std::string results_dir;
+
+    alns_params() {}
+    alns_params(double time_limit,
+                int max_iter,
+                int min_removed_requests,
+                double max_removed_fraction,
+                int segment_length,
+                double reaction_factor,
+                double start_temperature,
+                double cooling_rate,
+                unsigned seed,
+                std::string results_dir) :
+                time_limit{time_limit},
+                max_iter{max_iter},
+                min_removed_requests{min_removed_requests},
+                max_removed_fraction{max_removed_fraction},
+                segment_length{segment_length},
+                reaction_factor{reaction_factor},
+                start_temperature{start_temperature},
+                cooling_rate{cooling_rate},
+                seed{seed},
+                results_dir{results_dir} {}
+};
+
+#endif
\ No newline at end of file
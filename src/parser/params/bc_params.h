@@ -8,7 +8,9 @@ struct branch_and_cut_params {
     bool            two_cycles_elim;
     bool            subpath_elim;
     int             max_infeas_subpaths;
+    bool            lazy_model_rows;        // Two-cycle and subpath rows only enter the LP when violated
     bool            print_relaxation_graph;
+    bool            model_names;            // Name the rows and columns of the model, e.g. to read model.lp
     bool            use_initial_solutions;
     std::string     results_dir;
     
@@ -58,7 +60,9 @@ struct branch_and_cut_params {
     branch_and_cut_params(  bool two_cycles_elim,
                             bool subpath_elim,
                             int max_infeas_subpaths,
+                            bool lazy_model_rows,
                             bool print_relaxation_graph,
+                            bool model_names,
                             bool use_initial_solutions,
                             std::string results_dir,
                             valid_inequality_with_memory_info subtour_elim,
@@ -68,7 +72,9 @@ struct branch_and_cut_params {
                             two_cycles_elim{two_cycles_elim},
                             subpath_elim{subpath_elim},
                             max_infeas_subpaths{max_infeas_subpaths},
+                            lazy_model_rows{lazy_model_rows},
                             print_relaxation_graph{print_relaxation_graph},
+                            model_names{model_names},
                             use_initial_solutions{use_initial_solutions},
                             results_dir{results_dir},
                             subtour_elim{subtour_elim},
@@ -4,17 +4,23 @@
 #include <string>
 
 struct constructive_heuristics_params {
-    bool print_solutions;
+    bool        print_solutions;
     std::string results_dir;
     std::string solutions_dir;
+    int         insertion_max_requests; // Above this number of requests, only the savings heuristic is run
+    bool        use_mirror_instance;    // Also run the heuristics on the reversed problem, in parallel
     
     constructive_heuristics_params() {}
     constructive_heuristics_params( bool print_solutions,
                                     std::string results_dir,
-                                    std::string solutions_dir) :
+                                    std::string solutions_dir,
+                                    int insertion_max_requests,
+                                    bool use_mirror_instance) :
                                     print_solutions{print_solutions},
                                     results_dir{results_dir},
-                                    solutions_dir{solutions_dir} {}
+                                    solutions_dir{solutions_dir},
+                                    insertion_max_requests{insertion_max_requests},
+                                    use_mirror_instance{use_mirror_instance} {}
 };
 
 #endif
\ No newline at end of file
@@ -12,10 +12,23 @@ struct k_opt_params {
     
     using k_opt_limits = std::vector<k_opt_limit>;
     
-    k_opt_limits instance_size_limits;
+    k_opt_limits    instance_size_limits;
+    int             max_parallel_solvers; // Starting tours improved at the same time, sharing cplex_threads
+    double          time_limit;           // Time limit of a single k-opt MIP, in seconds
+    long            node_limit;           // Node limit of a single k-opt MIP
+    int             max_k;                // k grows after each improvement, up to this value
     
     k_opt_params() {}
-    k_opt_params(k_opt_limits instance_size_limits) : instance_size_limits{instance_size_limits} {}
+    k_opt_params(   k_opt_limits instance_size_limits,
+                    int max_parallel_solvers,
+                    double time_limit,
+                    long node_limit,
+                    int max_k) :
+                    instance_size_limits{instance_size_limits},
+                    max_parallel_solvers{max_parallel_solvers},
+                    time_limit{time_limit},
+                    node_limit{node_limit},
+                    max_k{max_k} {}
 };
 
 #endif
\ No newline at end of file
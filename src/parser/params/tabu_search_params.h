@@ -8,25 +8,88 @@ struct tabu_search_params {
     int         tabu_list_size;
     int         max_iter;
     int         max_iter_without_improving;
+    double      time_limit;             // Wall-clock budget of all the searches, in seconds (0 for none)
+    int         target_cost;            // The searches stop as soon as one finds a tour this cheap (0 for none)
     int         max_parallel_searches;
+    int         k_exchange_window;      // Window of the dynamic program run on the restart tours and the best tour of each search (0 to disable)
+    int         candidate_list_size;    // Successors per node in the granular 3-opt neighbourhood (0 for the full one)
+    int         scan_threads;           // Threads scanning the 3-opt neighbourhood of each iteration
+    std::string scan_policy;            // "full" (best move), "first" (first improving move in random order) or "sample"
+    int         scan_sample_size;       // Random moves evaluated at each iteration by the "sample" policy
+    int         elite_pool_size;        // Best tours shared by the searches (0 for independent searches)
+    int         migration_interval;     // Iterations between two exchanges of a search with the elite pool (0 to disable)
+    int         max_restarts;           // Restarts of each search from a perturbed elite tour
+    bool        request_moves;          // Descend with request relocations and swaps from new best tours
+    bool        reactive_tenure;        // Adapt the tabu list size to the repetitions of visited tours
+    int         min_tabu_list_size;     // Range of the reactive tabu list size...
+    int         max_tabu_list_size;
+    double      tenure_increase;        // ...which is multiplied by this when a tour is visited again...
+    double      tenure_decrease;        // ...and by this after tenure_decrease_interval iterations without repetitions
+    int         tenure_decrease_interval;
+    int         visited_tours_memory;   // Hashes of visited tours remembered by each search
+    int         relinking_elite_size;   // Best end tours relinked pairwise after the searches (0 or 1 to disable)
+    double      relinking_time_limit;   // Wall-clock budget of the path relinking, in seconds
     std::string results_dir;
     bool        track_progress;
+    int         progress_interval;      // Iterations between two progress records, besides those of new best tours
     std::string progress_results_dir;
     
     tabu_search_params() {}
     tabu_search_params( int tabu_list_size,
                         int max_iter,
                         int max_iter_without_improving,
+                        double time_limit,
+                        int target_cost,
                         int max_parallel_searches,
+                        int k_exchange_window,
+                        int candidate_list_size,
+                        int scan_threads,
+                        std::string scan_policy,
+                        int scan_sample_size,
+                        int elite_pool_size,
+                        int migration_interval,
+                        int max_restarts,
+                        bool request_moves,
+                        bool reactive_tenure,
+                        int min_tabu_list_size,
+                        int max_tabu_list_size,
+                        double tenure_increase,
+                        double tenure_decrease,
+                        int tenure_decrease_interval,
+                        int visited_tours_memory,
+                        int relinking_elite_size,
+                        double relinking_time_limit,
                         std::string results_dir,
                         bool track_progress,
+                        int progress_interval,
                         std::string progress_results_dir) : 
                         tabu_list_size{tabu_list_size},
                         max_iter{max_iter},
                         max_iter_without_improving{max_iter_without_improving},
+                        time_limit{time_limit},
+                        target_cost{target_cost},
                         max_parallel_searches{max_parallel_searches},
+                        k_exchange_window{k_exchange_window},
+                        candidate_list_size{candidate_list_size},
+                        scan_threads{scan_threads},
+                        scan_policy{scan_policy},
+                        scan_sample_size{scan_sample_size},
+                        elite_pool_size{elite_pool_size},
+                        migration_interval{migration_interval},
+                        max_restarts{max_restarts},
+                        request_moves{request_moves},
+                        reactive_tenure{reactive_tenure},
+                        min_tabu_list_size{min_tabu_list_size},
+                        max_tabu_list_size{max_tabu_list_size},
+                        tenure_increase{tenure_increase},
+                        tenure_decrease{tenure_decrease},
+                        tenure_decrease_interval{tenure_decrease_interval},
+                        visited_tours_memory{visited_tours_memory},
+                        relinking_elite_size{relinking_elite_size},
+                        relinking_time_limit{relinking_time_limit},
                         results_dir{results_dir},
                         track_progress{track_progress},
+                        progress_interval{progress_interval},
                         progress_results_dir{progress_results_dir} {}
 };
 
@@ -113,13 +113,19 @@ program_params  parser::read_program_params() const {
     
     return program_params(
         k_opt_params(
-            instance_size_limits
+            instance_size_limits,
+            pt.get<int>("k_opt.max_parallel_solvers"),
+            pt.get<double>("k_opt.time_limit"),
+            pt.get<long>("k_opt.node_limit"),
+            pt.get<int>("k_opt.max_k")
         ),
         branch_and_cut_params(
             pt.get<bool>("branch_and_cut.two_cycles_elim"),
             pt.get<bool>("branch_and_cut.subpath_elim"),
             pt.get<int>("branch_and_cut.max_infeas_subpaths"),
+            pt.get<bool>("branch_and_cut.lazy_model_rows"),
             pt.get<bool>("branch_and_cut.print_relaxation_graph"),
+            pt.get<bool>("branch_and_cut.model_names"),
             pt.get<bool>("branch_and_cut.use_initial_solutions"),
             pt.get<std::string>("branch_and_cut.results_dir"),
             branch_and_cut_params::valid_inequality_with_memory_info(
@@ -165,20 +171,56 @@ program_params  parser::read_program_params() const {
             pt.get<int>("tabu_search.tabu_list_size"),
             pt.get<int>("tabu_search.max_iter"),
             pt.get<int>("tabu_search.max_iter_without_improving"),
+            pt.get<double>("tabu_search.time_limit"),
+            pt.get<int>("tabu_search.target_cost"),
             pt.get<int>("tabu_search.max_parallel_searches"),
+            pt.get<int>("tabu_search.k_exchange_window"),
+            pt.get<int>("tabu_search.candidate_list_size"),
+            pt.get<int>("tabu_search.scan_threads"),
+            pt.get<std::string>("tabu_search.scan_policy"),
+            pt.get<int>("tabu_search.scan_sample_size"),
+            pt.get<int>("tabu_search.elite_pool_size"),
+            pt.get<int>("tabu_search.migration_interval"),
+            pt.get<int>("tabu_search.max_restarts"),
+            pt.get<bool>("tabu_search.request_moves"),
+            pt.get<bool>("tabu_search.reactive_tenure"),
+            pt.get<int>("tabu_search.min_tabu_list_size"),
+            pt.get<int>("tabu_search.max_tabu_list_size"),
+            pt.get<double>("tabu_search.tenure_increase"),
+            pt.get<double>("tabu_search.tenure_decrease"),
+            pt.get<int>("tabu_search.tenure_decrease_interval"),
+            pt.get<int>("tabu_search.visited_tours_memory"),
+            pt.get<int>("tabu_search.relinking_elite_size"),
+            pt.get<double>("tabu_search.relinking_time_limit"),
             pt.get<std::string>("tabu_search.results_dir"),
             pt.get<bool>("tabu_search.track_progress"),
+            pt.get<int>("tabu_search.progress_interval"),
             pt.get<std::string>("tabu_search.progress_results_dir")
         ),
         tabu_search_tuning_params(
             tabu_tuning_list_size
         ),
+        alns_params(
+            pt.get<double>("alns.time_limit"),
+            pt.get<int>("alns.max_iter"),
+            pt.get<int>("alns.min_removed_requests"),
+            pt.get<double>("alns.max_removed_fraction"),
+            pt.get<int>("alns.segment_length"),
+            pt.get<double>("alns.reaction_factor"),
+            pt.get<double>("alns.start_temperature"),
+            pt.get<double>("alns.cooling_rate"),
+            pt.get<unsigned>("alns.seed"),
+            pt.get<std::string>("alns.results_dir")
+        ),
         constructive_heuristics_params(
             pt.get<bool>("constructive_heuristics.print_solutions"),
             pt.get<std::string>("constructive_heuristics.results_dir"),
-            pt.get<std::string>("constructive_heuristics.solutions_dir")
+            pt.get<std::string>("constructive_heuristics.solutions_dir"),
+            pt.get<int>("constructive_heuristics.insertion_max_requests"),
+            pt.get<bool>("constructive_heuristics.use_mirror_instance")
         ),
         pt.get<int>("cplex_threads"),
-        pt.get<int>("cplex_timeout")
+        pt.get<int>("cplex_timeout"),
+        pt.get<int>("solution_pool_size")
     );
 }
\ No newline at end of file
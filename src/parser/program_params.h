@@ -1,6 +1,7 @@
 #ifndef PROGRAM_PARAMS_H
 #define PROGRAM_PARAMS_H
 
+#include <parser/params/alns_params.h>
 #include <parser/params/bc_params.h>
 #include <parser/params/constructive_heuristics_params.h>
 #include <parser/params/k_opt_params.h>
@@ -11,25 +12,31 @@ struct program_params  {
     branch_and_cut_params bc;
     tabu_search_params ts;
     tabu_search_tuning_params ts_tuning;
+    alns_params alns;
     constructive_heuristics_params ch;
     int cplex_threads;
     int cplex_timeout;
+    int solution_pool_size; // Best distinct tours passed from one phase to the next
     
     program_params() {}
     program_params( k_opt_params ko,
                     branch_and_cut_params bc,
                     tabu_search_params ts,
                     tabu_search_tuning_params ts_tuning,
+                    alns_params alns,
                     constructive_heuristics_params ch,
                     int cplex_threads,
-                    int cplex_timeout) : 
+                    int cplex_timeout,
+                    int solution_pool_size) : 
                     ko{ko},
                     bc{bc},
                     ts{ts},
                     ts_tuning{ts_tuning},
+                    alns{alns},
                     ch{ch},
                     cplex_threads{cplex_threads},
-                    cplex_timeout{cplex_timeout} {}
+                    cplex_timeout{cplex_timeout},
+                    solution_pool_size{solution_pool_size} {}
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include <program/elite_pool.h>
+
+#include <algorithm>
+#include <limits>
+
+elite_pool::elite_pool(int max_size) : max_size{max_size}, best{std::numeric_limits<int>::max()}, admission{std::numeric_limits<int>::max()} {}
+
+bool elite_pool::offer(const path& p) {
+    if(max_size <= 0 || p.path_v.empty() || p.total_cost >= admission) {
+        return false;
+    }
+    
+    return offer(std::make_shared<const path>(p));
+}
+
+bool elite_pool::offer(tour_ptr p) {
+    if(max_size <= 0 || !p || p->path_v.empty() || p->total_cost >= admission) {
+        return false;
+    }
+    
+    std::lock_guard<std::mutex> guard(mtx);
+    
+    // Another search may have raised the bar in the meantime
+    if(p->total_cost >= admission || hashes.count(p->hash) > 0u) {
+        return false;
+    }
+    
+    auto position = std::upper_bound(solutions.begin(), solutions.end(), p, [] (const tour_ptr& p1, const tour_ptr& p2) { return p1->total_cost < p2->total_cost; });
+    
+    hashes.insert(p->hash);
+    solutions.insert(position, std::move(p));
+    
+    if((int)solutions.size() > max_size) {
+        hashes.erase(solutions.back()->hash);
+        solutions.pop_back();
+    }
+    
+    best = solutions.front()->total_cost;
+    
+    if((int)solutions.size() == max_size) {
+        admission = solutions.back()->total_cost;
+    }
+    
+    return true;
+}
+
+tour_ptr elite_pool::pick(std::mt19937& gen) const {
+    std::lock_guard<std::mutex> guard(mtx);
+    
+    if(solutions.empty()) {
+        return nullptr;
+    }
+    
+    auto dis = std::uniform_int_distribution<int>(0, (int)solutions.size() - 1);
+    
+    return solutions[dis(gen)];
+}
+
+std::vector<tour_ptr> elite_pool::get_solutions() const {
+    std::lock_guard<std::mutex> guard(mtx);
+    
+    return solutions;
+}
\ No newline at end of file
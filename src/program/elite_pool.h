@@ -0,0 +1,45 @@
+#ifndef ELITE_POOL_H
+#define ELITE_POOL_H
+
+#include <network/path.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using tour_ptr = std::shared_ptr<const path>;
+
+// Best distinct tours found so far, shared by the phases of the program and by searches running
+// in parallel. Tours are immutable and reference-counted, so readers get them without copies, and
+// duplicates are detected by hash. The best cost and the cost a tour must beat to enter the pool
+// are atomics, so that searches can read them without locking.
+class elite_pool {
+    int                                 max_size;
+    std::vector<tour_ptr>               solutions; // Sorted by increasing cost
+    std::unordered_set<std::uint64_t>   hashes;
+    mutable std::mutex                  mtx;
+    std::atomic<int>                    best;
+    std::atomic<int>                    admission;
+
+public:
+    elite_pool(int max_size);
+    
+    bool enabled() const { return max_size > 0; }
+    int best_cost() const { return best; }
+    
+    // Return true if the tour entered the pool. The first one copies the tour only if it gets in
+    bool offer(const path& p);
+    bool offer(tour_ptr p);
+    
+    // A random tour of the pool, or nullptr if the pool is empty
+    tour_ptr pick(std::mt19937& gen) const;
+    
+    // Sorted by increasing cost
+    std::vector<tour_ptr> get_solutions() const;
+};
+
+#endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include <program/program.h>
 #include <solver/heuristics/heuristic_solver.h>
 #include <solver/bc/bc_solver.h>
+#include <solver/metaheuristics/alns/alns_solver.h>
 #include <solver/metaheuristics/tabu/tabu_solver.h>
 
 #include <fstream>
@@ -24,6 +25,7 @@ program::program(const std::vector<std::string>& args) {
         "tabu_only",
         "tabu_tuning",
         "tabu_and_branch_and_cut",
+        "alns_only",
         "branch_and_cut_tuning"
     };
     
@@ -32,6 +34,8 @@ program::program(const std::vector<std::string>& args) {
         return;
     }
     
+    // Every phase reads its starting tours from the pool and publishes its own tours to it
+    elite_pool solution_pool(params.solution_pool_size);
     auto heuristic_solutions = std::vector<path>();
     auto hsolv = heuristic_solver(g, params, data);
     
@@ -42,33 +46,36 @@ program::program(const std::vector<std::string>& args) {
             heuristic_solutions = hsolv.run_all_heuristics();
         }
     }
+    
+    for(const auto& p : heuristic_solutions) {
+        solution_pool.offer(p);
+    }
 
     if(args[2] == "constructive_heuristics_and_branch_and_cut") {
-        auto bsolv = bc_solver(g, params, data, heuristic_solutions);
+        auto bsolv = bc_solver(g, params, data, solution_pool);
         bsolv.solve_with_branch_and_cut();
     } else if(args[2] == "tabu_only" || args[2] == "tabu_and_branch_and_cut" || args[2] == "branch_and_cut_tuning") {
-        auto tsolv = tabu_solver(g, params, data, heuristic_solutions);
-        auto sols = tsolv.solve_sequential();
-        
-        if(args[2] != "tabu_only") {
-            heuristic_solutions.insert(heuristic_solutions.end(), sols.begin(), sols.end());
-        }
+        tabu_solver tsolv(g, params, data, solution_pool);
+        tsolv.solve();
         
         if(args[2] == "tabu_and_branch_and_cut") {
-            auto bsolv = bc_solver(g, params, data, heuristic_solutions);
+            auto bsolv = bc_solver(g, params, data, solution_pool);
             bsolv.solve_with_branch_and_cut();
         }
     } else if(args[2] == "tabu_tuning") {
-        auto tsolv = tabu_solver(g, params, data, heuristic_solutions);
+        tabu_solver tsolv(g, params, data, solution_pool);
         tsolv.solve_parameter_tuning();
+    } else if(args[2] == "alns_only") {
+        auto asolv = alns_solver(g, params, data, solution_pool);
+        asolv.solve();
     }
     
     if(args[2] == "branch_and_cut_tuning") {
-        try_all_combinations_of_bc(heuristic_solutions);
+        try_all_combinations_of_bc(solution_pool);
     }
 }
 
-void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solutions) {
+void program::try_all_combinations_of_bc(const elite_pool& solution_pool) {
     // 1) Basic model
     params.bc.two_cycles_elim = false;
     params.bc.subpath_elim = false;
@@ -78,7 +85,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     params.bc.fork.enabled = false;
     params.bc.fork.lifted = false;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -86,7 +93,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     // 2) Enable ONLY 2-cycle elimination
     params.bc.two_cycles_elim = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -95,7 +102,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     params.bc.two_cycles_elim = false;
     params.bc.subpath_elim = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -104,7 +111,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     params.bc.subpath_elim = false;
     params.bc.subtour_elim.enabled = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -113,7 +120,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     params.bc.subtour_elim.enabled = false;
     params.bc.generalised_order.enabled = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -122,7 +129,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     params.bc.generalised_order.enabled = false;
     params.bc.capacity.enabled = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -131,7 +138,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     params.bc.capacity.enabled = false;
     params.bc.fork.enabled = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -139,7 +146,7 @@ void program::try_all_combinations_of_bc(const std::vector<path>& heuristic_solu
     // 8) Enable ONLY FORK, IN-FORK, OUT-FORK cuts
     params.bc.fork.lifted = true;
     {
-        auto solv = bc_solver(g, params, data, heuristic_solutions);
+        auto solv = bc_solver(g, params, data, solution_pool);
         solv.solve_with_branch_and_cut();
     }
     data.reset_for_new_branch_and_cut();
@@ -161,5 +168,6 @@ void program::print_usage() {
                 << "\t tabu_only" << std::endl
                 << "\t tabu_tuning" << std::endl
                 << "\t tabu_and_branch_and_cut" << std::endl
+                << "\t alns_only" << std::endl
                 << "\t branch_and_cut_tuning" << std::endl;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <network/tsp_graph.h>
 #include <network/path.h>
 #include <parser/program_params.h>
+#include <program/elite_pool.h>
 #include <program/program_data.h>
 
 #include <memory>
@@ -16,7 +17,7 @@ class program {
     program_data    data;
     
     void load(const std::string& params_filename, const std::string& instance_filename);
-    void try_all_combinations_of_bc(const std::vector<path>& heuristic_solutions);
+    void try_all_combinations_of_bc(const elite_pool& solution_pool);
     void print_usage();
 
 public:
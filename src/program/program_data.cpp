@@ -7,6 +7,12 @@ void program_data::reset_times_and_cuts() {
     new_data.time_spent_by_constructive_heuristics = time_spent_by_constructive_heuristics;
     new_data.time_spent_by_k_opt_heuristics = time_spent_by_k_opt_heuristics;
     new_data.time_spent_by_tabu_search = time_spent_by_tabu_search;
+    new_data.time_spent_by_alns = time_spent_by_alns;
+    
+    new_data.k_opt_calls = k_opt_calls;
+    new_data.k_opt_improving_calls = k_opt_improving_calls;
+    new_data.k_opt_calls_at_limit = k_opt_calls_at_limit;
+    new_data.time_spent_by_improving_k_opt_calls = time_spent_by_improving_k_opt_calls;
     
     std::swap(*this, new_data);
 }
@@ -16,10 +22,17 @@ void program_data::reset_for_new_branch_and_cut() {
     new_data.time_spent_by_constructive_heuristics = time_spent_by_constructive_heuristics;
     new_data.time_spent_by_k_opt_heuristics = time_spent_by_k_opt_heuristics;
     new_data.time_spent_by_tabu_search = time_spent_by_tabu_search;
+    new_data.time_spent_by_alns = time_spent_by_alns;
+    
+    new_data.k_opt_calls = k_opt_calls;
+    new_data.k_opt_improving_calls = k_opt_improving_calls;
+    new_data.k_opt_calls_at_limit = k_opt_calls_at_limit;
+    new_data.time_spent_by_improving_k_opt_calls = time_spent_by_improving_k_opt_calls;
     
     new_data.n_constructive_solutions = n_constructive_solutions;
     new_data.best_constructive_solution = best_constructive_solution;
     new_data.best_tabu_solution = best_tabu_solution;
+    new_data.best_alns_solution = best_alns_solution;
     
     std::swap(*this, new_data);
 }
\ No newline at end of file
@@ -5,6 +5,7 @@ struct program_data {
     double time_spent_by_constructive_heuristics;
     double time_spent_by_k_opt_heuristics;
     double time_spent_by_tabu_search;
+    double time_spent_by_alns;
     
     double time_spent_separating_feasibility_cuts;
     double time_spent_separating_subtour_elimination_vi;
@@ -22,15 +23,26 @@ struct program_data {
     long total_number_of_infork_vi_added;
     long total_number_of_outfork_vi_added;
     
+    // Rows of the lazy two-cycle and subpath pool which entered the LP at least once
+    long total_number_of_two_cycles_rows_activated;
+    long total_number_of_subpath_rows_activated;
+    
+    long k_opt_calls;
+    long k_opt_improving_calls;
+    long k_opt_calls_at_limit;
+    double time_spent_by_improving_k_opt_calls;
+    
     int n_constructive_solutions;
     
     double best_constructive_solution;
     double best_tabu_solution;
+    double best_alns_solution;
     
     program_data() :
         time_spent_by_constructive_heuristics{0.0},
         time_spent_by_k_opt_heuristics{0.0},
         time_spent_by_tabu_search{0.0},
+        time_spent_by_alns{0.0},
         time_spent_separating_feasibility_cuts{0.0},
         time_spent_separating_subtour_elimination_vi{0.0},
         time_spent_separating_generalised_order_vi{0.0},
@@ -44,7 +56,13 @@ struct program_data {
         total_number_of_simplified_fork_vi_added{0},
         total_number_of_fork_vi_added{0},
         total_number_of_infork_vi_added{0},
-        total_number_of_outfork_vi_added{0} {}
+        total_number_of_outfork_vi_added{0},
+        total_number_of_two_cycles_rows_activated{0},
+        total_number_of_subpath_rows_activated{0},
+        k_opt_calls{0},
+        k_opt_improving_calls{0},
+        k_opt_calls_at_limit{0},
+        time_spent_by_improving_k_opt_calls{0.0} {}
         
     void reset_times_and_cuts();
     void reset_for_new_branch_and_cut();
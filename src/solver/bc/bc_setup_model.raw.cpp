@@ -1,58 +1,98 @@
 auto min3 = [] (auto x, auto y, auto z) { return std::min(x, std::min(y,z)); };
 auto max3 = [] (auto x, auto y, auto z) { return std::max(x, std::max(y,z)); };
 
-// ROWS
+// The model is built from sparse incidence lists: each column only visits the rows it appears
+// in, so that building it takes time linear in the number of nonzeros. Names are optional, as
+// they only help reading the exported model.
+auto model_names = params.bc.model_names;
 
-for(auto i = 0; i <= 2*n; i++) {
-    outdegree.add(IloRange(env, 1.0, 1.0));
-    outdegree[i].setName(("outdegree_" + std::to_string(i)).c_str());
-}
-for(auto i = 1; i <= 2*n + 1; i++) {
-    indegree.add(IloRange(env, 1.0, 1.0));
-    indegree[i-1].setName(("indegree_" + std::to_string(i)).c_str());
-}
-for(auto i = 1; i <= 2*n; i++) {
-    load.add(IloRange(env, g.demand[i], g.demand[i]));
-    load[i-1].setName(("load_" + std::to_string(i)).c_str());
-}
+// Arcs of the graph, in the order of the x and y columns and of the y_lower and y_upper rows.
+// arc_index[i][j] is the position of arc (i,j), or -1 if it was removed
+auto arcs = std::vector<std::pair<int, int>>();
+auto arc_index = std::vector<std::vector<int>>(2*n + 2, std::vector<int>(2*n + 2, -1));
 
-auto row_n = 0;
 for(auto i = 0; i <= 2*n + 1; i++) {
     for(auto j = 0; j <= 2*n + 1; j++) {
         if(g.cost[i][j] >= 0) {
-            y_lower.add(IloRange(env, -IloInfinity, 0.0));
-            y_lower[row_n].setName(("y_lower_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
-            y_upper.add(IloRange(env, 0.0, IloInfinity));
-            y_upper[row_n].setName(("y_upper_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
-            row_n++;
+            arc_index[i][j] = arcs.size();
+            arcs.push_back(std::make_pair(i, j));
         }
     }
 }
 
-if(k_opt || params.bc.two_cycles_elim) {
-    row_n = 0;
+// ROWS
+
+outdegree.add(IloRangeArray(env, 2*n + 1, 1.0, 1.0));
+indegree.add(IloRangeArray(env, 2*n + 1, 1.0, 1.0));
+y_lower.add(IloRangeArray(env, arcs.size(), -IloInfinity, 0.0));
+y_upper.add(IloRangeArray(env, arcs.size(), 0.0, IloInfinity));
+
+for(auto i = 1; i <= 2*n; i++) {
+    load.add(IloRange(env, g.demand[i], g.demand[i]));
+}
+
+if(model_names) {
+    for(auto i = 0; i <= 2*n; i++) {
+        outdegree[i].setName(("outdegree_" + std::to_string(i)).c_str());
+    }
+    for(auto i = 1; i <= 2*n + 1; i++) {
+        indegree[i-1].setName(("indegree_" + std::to_string(i)).c_str());
+    }
+    for(auto i = 1; i <= 2*n; i++) {
+        load[i-1].setName(("load_" + std::to_string(i)).c_str());
+    }
+    for(auto a = 0u; a < arcs.size(); a++) {
+        y_lower[a].setName(("y_lower_" + std::to_string(arcs[a].first) + "_" + std::to_string(arcs[a].second)).c_str());
+        y_upper[a].setName(("y_upper_" + std::to_string(arcs[a].first) + "_" + std::to_string(arcs[a].second)).c_str());
+    }
+}
+
+// Two-cycle row of each arc whose reverse arc also exists. With lazy_model_rows, the two-cycle
+// and subpath rows are left to the callbacks instead (see lazy_rows_pool)
+auto arc_two_cycles_row = std::vector<int>(arcs.size(), -1);
+
+if((k_opt || params.bc.two_cycles_elim) && !params.bc.lazy_model_rows) {
+    auto row_n = 0;
     for(auto i = 0; i <= 2*n + 1; i++) {
         for(auto j = i + 1; j <= 2*n + 1; j++) {
-            if(g.cost[i][j] >= 0 && g.cost[j][i] >= 0) {
+            if(arc_index[i][j] >= 0 && arc_index[j][i] >= 0) {
                 two_cycles_elimination.add(IloRange(env, -IloInfinity, 1.0));
-                two_cycles_elimination[row_n++].setName(("tce_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
+                if(model_names) {
+                    two_cycles_elimination[row_n].setName(("tce_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
+                }
+                arc_two_cycles_row[arc_index[i][j]] = row_n;
+                arc_two_cycles_row[arc_index[j][i]] = row_n;
+                row_n++;
             }
         }
     }
 }
 
-if(k_opt || params.bc.subpath_elim) {
-    row_n = 0;
+// Subpath rows of each arc, once for every time the arc appears in the subpath
+auto arc_subpath_rows = std::vector<std::vector<int>>(arcs.size());
+
+if((k_opt || params.bc.subpath_elim) && !params.bc.lazy_model_rows) {
+    auto row_n = 0;
     for(const auto& pi : g.infeas_list) {
         if(row_n < params.bc.max_infeas_subpaths) {
             if(pi.second) {
-                std::stringstream name;
-                name << "sub_";
-                for(auto i : pi.first) { name << i << "_"; }
-                name << "elim";
-            
-                subpath_elimination.add(IloRange(env, -IloInfinity, pi.first.size() - 2));
-                subpath_elimination[row_n++].setName(name.str().c_str());
+                if(model_names) {
+                    std::stringstream name;
+                    name << "sub_";
+                    for(auto i : pi.first) { name << i << "_"; }
+                    name << "elim";
+                    
+                    subpath_elimination.add(IloRange(env, -IloInfinity, pi.first.size() - 2, name.str().c_str()));
+                } else {
+                    subpath_elimination.add(IloRange(env, -IloInfinity, pi.first.size() - 2));
+                }
+                
+                for(auto path_pos = 0u; path_pos < pi.first.size() - 1; path_pos++) {
+                    auto a = arc_index[pi.first[path_pos]][pi.first[path_pos + 1]];
+                    if(a >= 0) { arc_subpath_rows[a].push_back(row_n); }
+                }
+                
+                row_n++;
             }
         } else {
             break;
@@ -61,131 +101,78 @@ if(k_opt || params.bc.subpath_elim) {
 }
 
 // COLUMNS
-#include <boost/functional/hash.hpp>
-
-auto ij_to_column = std::unordered_map<std::pair<int, int>, int, boost::hash<std::pair<int, int>>>();
-auto col_n = 0;
-
-for(auto i = 0; i <= 2*n + 1; i++) {
-    for(auto j = 0; j <= 2*n + 1; j++) {
-        if(g.cost[i][j] >= 0) {
-            IloNumColumn col = obj(g.cost[i][j]);
-
-            for(auto ii = 0; ii <= 2*n; ii++) {
-                if(i == ii) { col += outdegree[ii](1); }
-            }
-                        
-            for(auto jj = 1; jj <= 2*n + 1; jj++) {
-                if(j == jj) { col += indegree[jj-1](1); }
-            }
-                        
-            auto row_n = 0;
-            for(auto ii = 0; ii <= 2*n + 1; ii++) {
-                for(auto jj = 0; jj <= 2*n + 1; jj++) {
-                    if(g.cost[ii][jj] >= 0) {
-                        auto alpha = 0;
-                        auto beta = 0;
-                        
-                        if(i == ii && j == jj) {
-                            if(i >= 1 && i <= n && j >= 1 && j <= n) { alpha = g.demand[i]; }
-                            if(i >= n+1 && i <= 2*n && j >= n+1 && j <= 2*n) { alpha = -g.demand[j]; }
-                            if(i >= 1 && i <= n && j >= n+1 && j <= 2*n) {
-                                if(j != i+n) {
-                                    alpha = g.demand[i] - g.demand[j];
-                                } else {
-                                    alpha = g.demand[i];
-                                }
-                            }
-
-                            beta = min3(
-                                g.draught[i] + std::min(0, g.demand[i]),
-                                g.draught[j] - std::max(0, g.demand[j]),
-                                Q - max3(0, -g.demand[i], g.demand[j])
-                            );
 
-                            // Old version (the new one is tighter than this):
-                            // beta = std::min(std::min(Q - std::max(0, g.demand[j]), g.draught[i]), g.draught[j] - std::max(0, g.demand[j]));
-                        }
-                        
-                        col += y_lower[row_n](alpha);
-                        col += y_upper[row_n](beta);
-                        row_n++;
-                    }
-                }
-            }
-            
-            if(k_opt || params.bc.two_cycles_elim) {
-                row_n = 0;
-                for(auto ii = 0; ii <= 2*n + 1; ii++) {
-                    for(auto jj = ii + 1; jj <= 2*n + 1; jj++) {
-                        if(g.cost[ii][jj] >= 0 && g.cost[jj][ii] >= 0) {
-                            if((i == ii && j == jj) || (i == jj && j == ii)) {
-                                col += two_cycles_elimination[row_n](1);
-                            }
-                            row_n++;
-                        }
-                    }
-                }
-            }
-            
-            if(k_opt || params.bc.subpath_elim) {
-                row_n = 0;
-                for(const auto& pi : g.infeas_list) {
-                    if(row_n < params.bc.max_infeas_subpaths) {
-                        if(pi.second) {
-                            for(auto path_pos = 0u; path_pos < pi.first.size() - 1; path_pos++) {
-                                if(i == pi.first[path_pos] && j == pi.first[path_pos + 1]) {
-                                    col += subpath_elimination[row_n](1);
-                                }
-                            }
-                            row_n++;
-                        }
-                    } else {
-                        break;
-                    }
-                }
-            }
-            
-            if(k_opt) {
-                col += k_opt_constraint(k_opt_lhs[i][j]);
-            }
-            
-            IloNumVar v(col, 0.0, 1.0, IloNumVar::Bool, ("x_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
-            variables_x.add(v);
-            ij_to_column[std::make_pair(i,j)] = col_n++;
-            col.end();
+for(auto a = 0u; a < arcs.size(); a++) {
+    auto i = arcs[a].first;
+    auto j = arcs[a].second;
+    
+    IloNumColumn col = obj(g.cost[i][j]);
+    
+    if(i <= 2*n) { col += outdegree[i](1); }
+    if(j >= 1) { col += indegree[j-1](1); }
+    
+    auto alpha = 0;
+    
+    if(i >= 1 && i <= n && j >= 1 && j <= n) { alpha = g.demand[i]; }
+    if(i >= n+1 && i <= 2*n && j >= n+1 && j <= 2*n) { alpha = -g.demand[j]; }
+    if(i >= 1 && i <= n && j >= n+1 && j <= 2*n) {
+        if(j != i+n) {
+            alpha = g.demand[i] - g.demand[j];
+        } else {
+            alpha = g.demand[i];
         }
     }
+    
+    auto beta = min3(
+        g.draught[i] + std::min(0, g.demand[i]),
+        g.draught[j] - std::max(0, g.demand[j]),
+        Q - max3(0, -g.demand[i], g.demand[j])
+    );
+    
+    // Old version (the new one is tighter than this):
+    // beta = std::min(std::min(Q - std::max(0, g.demand[j]), g.draught[i]), g.draught[j] - std::max(0, g.demand[j]));
+    
+    col += y_lower[a](alpha);
+    col += y_upper[a](beta);
+    
+    if(arc_two_cycles_row[a] >= 0) {
+        col += two_cycles_elimination[arc_two_cycles_row[a]](1);
+    }
+    
+    for(auto row_n : arc_subpath_rows[a]) {
+        col += subpath_elimination[row_n](1);
+    }
+    
+    if(k_opt) {
+        col += k_opt_constraint(k_opt_lhs[i][j]);
+    }
+    
+    if(model_names) {
+        variables_x.add(IloNumVar(col, 0.0, 1.0, IloNumVar::Bool, ("x_" + std::to_string(i) + "_" + std::to_string(j)).c_str()));
+    } else {
+        variables_x.add(IloNumVar(col, 0.0, 1.0, IloNumVar::Bool));
+    }
+    col.end();
 }
 
-for(auto i = 0; i <= 2*n + 1; i++) {
-    for(auto j = 0; j <= 2*n + 1; j++) {
-        if(g.cost[i][j] >= 0) {
-            IloNumColumn col = obj(0);
-            
-            for(auto ii = 1; ii <= 2*n; ii++) {
-                if(i == ii) { col += load[ii-1](1); }
-                if(j == ii) { col += load[ii-1](-1); }
-            }
-            
-            auto row_n = 0;
-            for(auto ii = 0; ii <= 2*n + 1; ii++) {
-                for(auto jj = 0; jj <= 2*n + 1; jj++) {
-                    if(g.cost[ii][jj] >= 0) {
-                        if(i == ii && j == jj) {
-                            col += y_lower[row_n](-1);
-                            col += y_upper[row_n](-1);
-                        }
-                        row_n++;
-                    }
-                }
-            }
-            
-            col += initial_load(i == 0 ? 1 : 0);
-            
-            IloNumVar v(col, 0.0, Q, IloNumVar::Int, ("y_" + std::to_string(i) + "_" + std::to_string(j)).c_str());
-            variables_y.add(v);
-            col.end();
-        }
+for(auto a = 0u; a < arcs.size(); a++) {
+    auto i = arcs[a].first;
+    auto j = arcs[a].second;
+    
+    IloNumColumn col = obj(0);
+    
+    if(i >= 1 && i <= 2*n) { col += load[i-1](1); }
+    if(j >= 1 && j <= 2*n) { col += load[j-1](-1); }
+    
+    col += y_lower[a](-1);
+    col += y_upper[a](-1);
+    
+    if(i == 0) { col += initial_load(1); }
+    
+    if(model_names) {
+        variables_y.add(IloNumVar(col, 0.0, Q, IloNumVar::Int, ("y_" + std::to_string(i) + "_" + std::to_string(j)).c_str()));
+    } else {
+        variables_y.add(IloNumVar(col, 0.0, Q, IloNumVar::Int));
     }
+    col.end();
 }
\ No newline at end of file
@@ -16,55 +16,24 @@
 #include <sstream>
 #include <stdexcept>
 
-bc_solver::bc_solver(tsp_graph& g, const program_params& params, program_data& data, const std::vector<path>& initial_solutions) : g{g}, params{params}, data{data}, initial_solutions{initial_solutions} {
-    add_initial_solution_vals();
+bc_solver::bc_solver(tsp_graph& g, const program_params& params, program_data& data, const elite_pool& solution_pool) : g{g}, params{params}, data{data}, initial_solutions{solution_pool.get_solutions()} {
+    verify_initial_solutions();
     create_results_dir(0750, params.bc.results_dir + g.g[graph_bundle].instance_dir);
 }
 
-void bc_solver::add_initial_solution_vals() {
-    auto n = g.g[graph_bundle].n;
-    
-    initial_x_val = std::vector<values_matrix>(initial_solutions.size());
-    initial_y_val = std::vector<values_matrix>(initial_solutions.size());
-    
-    for(auto sol_n = 0u; sol_n < initial_solutions.size(); sol_n++) {
-        if(!initial_solutions.at(sol_n).verify_feasible(g)) {
-            std::cerr << "bc_solver.cpp::add_initial_solution_vals() \t I have an unfeasible initial solution!" << std::endl;
-        }
-        
-        auto initial_x_sol = values_matrix(2 * n + 2, std::vector<int>(2 * n + 2, 0));
-        auto initial_y_sol = values_matrix(2 * n + 2, std::vector<int>(2 * n + 2, 0));
-
-        for(auto l = 0; l < 2 * n + 2; l++) {
-            if(l < 2 * n + 2 - 1) {
-                initial_x_sol[initial_solutions.at(sol_n).path_v[l]][initial_solutions.at(sol_n).path_v[l+1]] = 1;
-                initial_y_sol[initial_solutions.at(sol_n).path_v[l]][initial_solutions.at(sol_n).path_v[l+1]] = initial_solutions.at(sol_n).load_v[l];
-            }
+void bc_solver::verify_initial_solutions() const {
+    for(const auto& solution : initial_solutions) {
+        if(!solution->verify_feasible(g)) {
+            std::cerr << "bc_solver.cpp::verify_initial_solutions() \t I have an unfeasible initial solution!" << std::endl;
         }
-    
-        initial_x_val[sol_n] = initial_x_sol;
-        initial_y_val[sol_n] = initial_y_sol;
     }
 }
 
-path bc_solver::solve_for_k_opt(const path& solution, const std::vector<std::vector<int>>& lhs, int rhs) {
-    k_opt_lhs = lhs;
-    k_opt_rhs = rhs;
-    
-    initial_solutions.clear();
-    initial_solutions.push_back(solution);
-    
-    add_initial_solution_vals();
-    
-    return solve(true);
-}
-
 void bc_solver::solve_with_branch_and_cut() {
-    solve(false);
-}
-
-path bc_solver::solve(bool k_opt) {
     using namespace std::chrono;
+    
+    // The model setup is shared with k_opt_solver, which builds it with the k-opt constraint
+    const auto k_opt = false;
 
     auto unfeasible_paths_n = std::count_if(g.infeas_list.begin(), g.infeas_list.end(),
         [] (const auto& kv) -> bool {
@@ -73,15 +42,20 @@ path bc_solver::solve(bool k_opt) {
     );
 
     if(DEBUG) {
-        std::cerr << "bc_solver.cpp::solve() \t Invoked with k_opt = " << std::boolalpha << k_opt;
+        std::cerr << "bc_solver.cpp::solve() \t Invoked";
         if(!initial_solutions.empty()) {
-            std::cerr << " (initial solution value: " << initial_solutions.back().total_cost << ")" << std::endl;
+            std::cerr << " (initial solution value: " << initial_solutions.back()->total_cost << ")" << std::endl;
         } else {
             std::cerr << std::endl;
         }
     
+        std::cerr << "bc_solver.cpp::solve() \t The graph has " << num_edges(g.g) << " arcs (" << g.g[graph_bundle].arcs_removed_by_paths << " removed by the 3-paths preprocessing)" << std::endl;
         std::cerr << "bc_solver.cpp::solve() \t Currently have " << unfeasible_paths_n << " precomputed unfeasible sub-paths" << std::endl;
-        std::cerr << "bc_solver.cpp::solve() \t Adding up to " << params.bc.max_infeas_subpaths << " unfeasible sub-paths to the model" << std::endl;
+        if(params.bc.lazy_model_rows) {
+            std::cerr << "bc_solver.cpp::solve() \t Separating all the unfeasible sub-paths in the callbacks" << std::endl;
+        } else {
+            std::cerr << "bc_solver.cpp::solve() \t Adding up to " << params.bc.max_infeas_subpaths << " unfeasible sub-paths to the model" << std::endl;
+        }
     }
 
     auto total_bb_nodes_explored = (long)0;
@@ -113,7 +87,7 @@ path bc_solver::solve(bool k_opt) {
     IloRangeArray two_cycles_elimination(env);
     IloRangeArray subpath_elimination(env);
     IloRangeArray clique(env);
-    IloRange      k_opt_constraint(env, k_opt_rhs, IloInfinity, "k_opt_constraint");
+    IloRange      k_opt_constraint;
 
     IloObjective obj = IloMinimize(env);
     
@@ -138,34 +112,27 @@ path bc_solver::solve(bool k_opt) {
     model.add(y_lower);
     model.add(load);
     model.add(initial_load);
-    if(k_opt || params.bc.two_cycles_elim) {
+    if(params.bc.two_cycles_elim) {
         model.add(two_cycles_elimination);
     }
-    if(k_opt || params.bc.subpath_elim) {
+    if(params.bc.subpath_elim) {
         model.add(subpath_elimination);
     }
-    if(k_opt) {
-        model.add(k_opt_constraint);
-    }
     
     IloCplex cplex(model);
      
-    // Add initial solutions
-    for(auto sol_n = 0u; sol_n < initial_solutions.size(); sol_n++) {
+    // Add initial solutions. Each start only sets the x and y variables of the 2n+1 arcs of the
+    // tour: CPLEX completes it, and the outdegree and indegree rows leave 0 to all the other arcs
+    for(const auto& solution : initial_solutions) {
         IloNumVarArray initial_vars(env);
         IloNumArray initial_values(env);
-
-        auto col_idx = 0;
-        for(auto i = 0; i <= 2 * n + 1; i++) {
-            for(auto j = 0; j <= 2 * n + 1; j++) {
-                if(g.cost[i][j] >= 0) {
-                    initial_vars.add(variables_x[col_idx]);
-                    initial_values.add(initial_x_val[sol_n][i][j]);
-                    initial_vars.add(variables_y[col_idx]);
-                    initial_values.add(initial_y_val[sol_n][i][j]);
-                    col_idx++;
-                }
-            }
+        
+        for(auto l = 0u; l + 1 < solution->path_v.size(); l++) {
+            auto col = arc_index[solution->path_v[l]][solution->path_v[l+1]];
+            initial_vars.add(variables_x[col]);
+            initial_values.add(1);
+            initial_vars.add(variables_y[col]);
+            initial_values.add(solution->load_v[l]);
         }
 
         cplex.addMIPStart(initial_vars, initial_values);
@@ -174,8 +141,7 @@ path bc_solver::solve(bool k_opt) {
         constraints.add(outdegree); constraints.add(indegree);
         constraints.add(y_upper); constraints.add(y_lower);
         constraints.add(load); constraints.add(initial_load);
-        if(k_opt || params.bc.two_cycles_elim) { constraints.add(two_cycles_elimination); }
-        if(k_opt) { constraints.add(k_opt_constraint); }
+        if(params.bc.two_cycles_elim) { constraints.add(two_cycles_elimination); }
 
         IloNumArray preferences(env);
         for(auto i = 0; i < constraints.getSize(); i++) { preferences.add(1.0); }
@@ -200,18 +166,17 @@ path bc_solver::solve(bool k_opt) {
     // Add callbacks to separate cuts
     auto gr_with_reverse = g.make_reverse_tsp_graph();
     auto last_solution = IloNumArray(env);
-    cplex.use(cuts_lazy_constraint_handle(env, variables_x, g, gr_with_reverse, data));
-    cplex.use(cuts_callback_handle(env, variables_x, k_opt, g, gr_with_reverse, params, data, last_solution));
+    lazy_rows_pool lazy_rows(g, params.bc.lazy_model_rows && params.bc.two_cycles_elim, params.bc.lazy_model_rows && params.bc.subpath_elim);
+    cplex.use(cuts_lazy_constraint_handle(env, variables_x, g, gr_with_reverse, data, lazy_rows));
+    cplex.use(cuts_callback_handle(env, variables_x, k_opt, g, gr_with_reverse, params, data, last_solution, lazy_rows));
     
     // Add callback to print graphviz stuff
-    if(!k_opt && params.bc.print_relaxation_graph) {
+    if(params.bc.print_relaxation_graph) {
         cplex.use(print_relaxation_graph_callback_handle(env, variables_x, variables_y, g));
     }
 
     // Export model to file
-    if(!k_opt) {
-        cplex.exportModel("model.lp");
-    }
+    cplex.exportModel("model.lp");
     
     // Set CPLEX parameters
     cplex.setParam(IloCplex::TiLim, params.cplex_timeout);
@@ -219,10 +184,6 @@ path bc_solver::solve(bool k_opt) {
     cplex.setParam(IloCplex::Param::Parallel, IloCplex::Opportunistic);
     cplex.setParam(IloCplex::NodeLim, 0);
     
-    if(k_opt && !DEBUG) {
-        cplex.setOut(env.getNullStream());
-    }
-    
     auto t_start = high_resolution_clock::now();
 
     // Solve root node
@@ -266,12 +227,10 @@ path bc_solver::solve(bool k_opt) {
     auto t_end_total = high_resolution_clock::now();
     auto time_span_total = duration_cast<duration<double>>(t_end_total - t_start);
 
-    if(!k_opt) {
-        std::cerr << "bc_solver.cpp::solve() \t CPLEX status: " << cplex.getStatus() << std::endl;
-        std::cerr << "bc_solver.cpp::solve() \t CPLEX ext status: " << cplex.getCplexStatus() << std::endl;
-        if(cplex.isPrimalFeasible()) {
-            std::cerr << "bc_solver.cpp::solve() \t Objective value: " << cplex.getObjValue() << std::endl;
-        }
+    std::cerr << "bc_solver.cpp::solve() \t CPLEX status: " << cplex.getStatus() << std::endl;
+    std::cerr << "bc_solver.cpp::solve() \t CPLEX ext status: " << cplex.getCplexStatus() << std::endl;
+    if(cplex.isPrimalFeasible()) {
+        std::cerr << "bc_solver.cpp::solve() \t Objective value: " << cplex.getObjValue() << std::endl;
     }
 
     total_bb_nodes_explored = cplex.getNnodes();
@@ -285,10 +244,6 @@ path bc_solver::solve(bool k_opt) {
     
     total_cplex_time = time_span_total.count();
     
-    if(k_opt) { data.time_spent_by_k_opt_heuristics += total_cplex_time; }
-    
-    auto opt_solution_path = path();
-    
     if(cplex.isPrimalFeasible()) {
         // Get solution
         IloNumArray x(env);
@@ -309,24 +264,20 @@ path bc_solver::solve(bool k_opt) {
         
         x.end();
         
-        if(DEBUG && !k_opt) {
+        if(DEBUG) {
             print_x_variables(solution_x);
         }
         
-        opt_solution_path = path(g, solution_x);
+        auto opt_solution_path = path(g, solution_x);
     
         if(!opt_solution_path.verify_feasible(g)) {
             std::cerr << "bc_solver.cpp::solve() \t The optimal solution is infeasible!" << std::endl;
         }
     }
     
-    if(!k_opt) {
-        print_results(total_cplex_time, time_spent_at_root, ub, lb, ub_at_root, lb_at_root, number_of_cuts_added_at_root, unfeasible_paths_n, total_bb_nodes_explored);
-    }
+    print_results(total_cplex_time, time_spent_at_root, ub, lb, ub_at_root, lb_at_root, number_of_cuts_added_at_root, unfeasible_paths_n, total_bb_nodes_explored);
 
     env.end();
-
-    return opt_solution_path;
 }
 
 void bc_solver::print_x_variables(std::vector<std::vector<int>> x) {
@@ -481,7 +432,22 @@ void bc_solver::print_results(double total_cplex_time, double time_spent_at_root
     results_file << total_bb_nodes_explored << "\t";
     
     // ARCS IN GRAPH
-    results_file << num_edges(g.g) << std::endl;
+    results_file << num_edges(g.g) << "\t";
+    
+    // ARCS REMOVED BY 3-PATHS
+    results_file << g.g[graph_bundle].arcs_removed_by_paths << "\t";
+    
+    // LAZY ROWS ACTIVATED
+    if(params.bc.lazy_model_rows && params.bc.two_cycles_elim) {
+        results_file << data.total_number_of_two_cycles_rows_activated << "\t";
+    } else {
+        results_file << "no\t";
+    }
+    if(params.bc.lazy_model_rows && params.bc.subpath_elim) {
+        results_file << data.total_number_of_subpath_rows_activated << std::endl;
+    } else {
+        results_file << "no" << std::endl;
+    }
 
     results_file.close();
 }
@@ -41,6 +41,16 @@ void cuts_callback::main() {
         data.total_number_of_feasibility_cuts_added++;
     }
     
+    auto lazy_rows_violated = lazy_rows.separate(sol_from_cplex.sol, env, x, data);
+    
+    if(DEBUG && lazy_rows_violated.size() > 0) {
+        std::cerr << "cuts_callback.cpp::main() [" << node_number << "]\t Adding " << lazy_rows_violated.size() << " two-cycle and subpath rows" << std::endl;
+    }
+    
+    for(auto& row : lazy_rows_violated) {
+        add(row, IloCplex::UseCutForce).end();
+    }
+    
     bool separate_se = (
         (k_opt || params.bc.subtour_elim.enabled) &&
         should_separate(node_number, params.bc.subtour_elim.n1, params.bc.subtour_elim.n2, params.bc.subtour_elim.p1, params.bc.subtour_elim.p2, params.bc.subtour_elim.p3) &&
@@ -11,6 +11,7 @@
 #include <parser/program_params.h>
 #include <program/program_data.h>
 #include <solver/bc/callbacks/callbacks_helper.h>
+#include <solver/bc/callbacks/lazy_rows_pool.h>
 
 #include <ilcplex/ilocplex.h>
 #include <ilcplex/ilocplexi.h>
@@ -34,6 +35,7 @@ class cuts_callback : public IloCplex::UserCutCallbackI {
     const program_params&   params;
     program_data&           data;
     IloNumArray&            last_solution;
+    lazy_rows_pool&         lazy_rows;
     
     int last_node_no_se;
     int last_node_no_go;
@@ -46,7 +48,7 @@ class cuts_callback : public IloCplex::UserCutCallbackI {
     solution_from_cplex compute_x_values() const;
     
 public:
-    cuts_callback(const IloEnv& env, const IloNumVarArray& x, bool k_opt, tsp_graph& g, const tsp_graph& gr, const program_params& params, program_data& data, IloNumArray& last_solution) :
+    cuts_callback(const IloEnv& env, const IloNumVarArray& x, bool k_opt, tsp_graph& g, const tsp_graph& gr, const program_params& params, program_data& data, IloNumArray& last_solution, lazy_rows_pool& lazy_rows) :
         IloCplex::UserCutCallbackI{env},
         env{env},
         x{x},
@@ -56,6 +58,7 @@ public:
         params{params},
         data{data},
         last_solution{last_solution},
+        lazy_rows{lazy_rows},
         last_node_no_se{-1},
         last_node_no_go{-1},
         last_node_no_cap{-1},
@@ -69,8 +72,8 @@ public:
     void main();
 };
 
-inline IloCplex::Callback cuts_callback_handle(const IloEnv& env, const IloNumVarArray& x, bool k_opt, tsp_graph& g, const tsp_graph& gr, const program_params& params, program_data& data, IloNumArray& last_solution) {
-    return (IloCplex::Callback(new(env) cuts_callback(env, x, k_opt, g, gr, params, data, last_solution)));
+inline IloCplex::Callback cuts_callback_handle(const IloEnv& env, const IloNumVarArray& x, bool k_opt, tsp_graph& g, const tsp_graph& gr, const program_params& params, program_data& data, IloNumArray& last_solution, lazy_rows_pool& lazy_rows) {
+    return (IloCplex::Callback(new(env) cuts_callback(env, x, k_opt, g, gr, params, data, last_solution, lazy_rows)));
 }
 
 #endif
\ No newline at end of file
@@ -23,6 +23,11 @@ void cuts_lazy_constraint::main() {
         add(cut, IloCplex::UseCutForce).end();
         data.total_number_of_feasibility_cuts_added++;
     }
+    
+    // Rows of the model left out of the LP: the solution must satisfy them too
+    for(IloRange row : lazy_rows.separate(sol, env, x, data)) {
+        add(row, IloCplex::UseCutForce).end();
+    }
 }
 
 ch::solution cuts_lazy_constraint::compute_x_values() const {
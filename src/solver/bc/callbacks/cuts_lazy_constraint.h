@@ -11,6 +11,7 @@
 #include <parser/program_params.h>
 #include <program/program_data.h>
 #include <solver/bc/callbacks/callbacks_helper.h>
+#include <solver/bc/callbacks/lazy_rows_pool.h>
 
 #include <ilcplex/ilocplex.h>
 #include <ilcplex/ilocplexi.h>
@@ -23,18 +24,19 @@ class cuts_lazy_constraint : public IloCplex::LazyConstraintCallbackI {
     const tsp_graph&    g;
     const tsp_graph&    gr;
     program_data&       data;
+    lazy_rows_pool&     lazy_rows;
     
     ch::solution compute_x_values() const;
 
 public:
-    cuts_lazy_constraint(const IloEnv& env, const IloNumVarArray& x, const tsp_graph& g, const tsp_graph& gr, program_data& data) : IloCplex::LazyConstraintCallbackI{env}, env{env}, x{x}, g{g}, gr{gr}, data{data} {}
+    cuts_lazy_constraint(const IloEnv& env, const IloNumVarArray& x, const tsp_graph& g, const tsp_graph& gr, program_data& data, lazy_rows_pool& lazy_rows) : IloCplex::LazyConstraintCallbackI{env}, env{env}, x{x}, g{g}, gr{gr}, data{data}, lazy_rows{lazy_rows} {}
 
     IloCplex::CallbackI* duplicateCallback() const;
     void main();
 };
 
-inline IloCplex::Callback cuts_lazy_constraint_handle(const IloEnv& env, const IloNumVarArray& x, const tsp_graph& g, const tsp_graph& gr, program_data& data) {
-    return (IloCplex::Callback(new(env) cuts_lazy_constraint(env, x, g, gr, data)));
+inline IloCplex::Callback cuts_lazy_constraint_handle(const IloEnv& env, const IloNumVarArray& x, const tsp_graph& g, const tsp_graph& gr, program_data& data, lazy_rows_pool& lazy_rows) {
+    return (IloCplex::Callback(new(env) cuts_lazy_constraint(env, x, g, gr, data, lazy_rows)));
 }
 
 #endif
\ No newline at end of file
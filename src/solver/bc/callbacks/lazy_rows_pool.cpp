@@ -0,0 +1,112 @@
+#include <solver/bc/callbacks/lazy_rows_pool.h>
+
+// Unlike the static rows, the pool takes every infeasible subpath: max_infeas_subpaths doesn't apply
+lazy_rows_pool::lazy_rows_pool(const tsp_graph& g, bool two_cycles_elim, bool subpath_elim) {
+    auto n = g.g[graph_bundle].n;
+    auto col_index = 0;
+    
+    arc_column = std::vector<std::vector<int>>(2 * n + 2, std::vector<int>(2 * n + 2, -1));
+    
+    for(auto i = 0; i <= 2 * n + 1; i++) {
+        for(auto j = 0; j <= 2 * n + 1; j++) {
+            if(g.cost[i][j] >= 0) {
+                arc_column[i][j] = col_index++;
+            }
+        }
+    }
+    
+    if(two_cycles_elim) {
+        for(auto i = 0; i <= 2 * n + 1; i++) {
+            for(auto j = i + 1; j <= 2 * n + 1; j++) {
+                if(arc_column[i][j] >= 0 && arc_column[j][i] >= 0) {
+                    two_cycles.push_back(std::make_pair(i, j));
+                }
+            }
+        }
+    }
+    
+    if(subpath_elim) {
+        for(const auto& pi : g.infeas_list) {
+            if(!pi.second) {
+                continue;
+            }
+            
+            auto all_arcs_in_graph = true;
+            
+            for(auto path_pos = 0u; path_pos < pi.first.size() - 1; path_pos++) {
+                if(arc_column[pi.first[path_pos]][pi.first[path_pos + 1]] < 0) {
+                    all_arcs_in_graph = false;
+                    break;
+                }
+            }
+            
+            // A subpath using a removed arc can't be violated
+            if(all_arcs_in_graph) {
+                subpaths.push_back(pi.first);
+            }
+        }
+    }
+    
+    two_cycle_activated = std::vector<std::atomic<bool>>(two_cycles.size());
+    subpath_activated = std::vector<std::atomic<bool>>(subpaths.size());
+}
+
+std::vector<IloRange> lazy_rows_pool::separate(const ch::solution& sol, const IloEnv& env, const IloNumVarArray& x, program_data& data) {
+    auto rows = std::vector<IloRange>();
+    
+    for(auto r = 0u; r < two_cycles.size(); r++) {
+        auto i = two_cycles[r].first;
+        auto j = two_cycles[r].second;
+        
+        if(sol.x[i][j] + sol.x[j][i] > 1 + ch::eps(1)) {
+            // x_ij + x_ji <= 1 is the row of the subpath i, j, i
+            rows.push_back(make_row(env, x, {i, j, i}, 1.0));
+            
+            if(!two_cycle_activated[r].exchange(true)) {
+                data.total_number_of_two_cycles_rows_activated++;
+            }
+        }
+    }
+    
+    for(auto r = 0u; r < subpaths.size(); r++) {
+        const auto& nodes = subpaths[r];
+        auto lhs = 0.0;
+        auto rhs = nodes.size() - 2.0;
+        
+        // Each arc takes at most 1, so the row can only be violated if every arc is used
+        for(auto path_pos = 0u; path_pos < nodes.size() - 1; path_pos++) {
+            auto value = sol.x[nodes[path_pos]][nodes[path_pos + 1]];
+            
+            if(value < ch::eps(1)) {
+                lhs = 0.0;
+                break;
+            }
+            
+            lhs += value;
+        }
+        
+        if(lhs > rhs + ch::eps(rhs)) {
+            rows.push_back(make_row(env, x, nodes, rhs));
+            
+            if(!subpath_activated[r].exchange(true)) {
+                data.total_number_of_subpath_rows_activated++;
+            }
+        }
+    }
+    
+    return rows;
+}
+
+// Sum of the x variables of the arcs along nodes, at most rhs
+IloRange lazy_rows_pool::make_row(const IloEnv& env, const IloNumVarArray& x, const std::vector<int>& nodes, double rhs) const {
+    IloExpr lhs(env);
+    
+    for(auto path_pos = 0u; path_pos < nodes.size() - 1; path_pos++) {
+        lhs += x[arc_column[nodes[path_pos]][nodes[path_pos + 1]]];
+    }
+    
+    IloRange row;
+    row = (lhs <= rhs);
+    
+    return row;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef LAZY_ROWS_POOL_H
+#define LAZY_ROWS_POOL_H
+
+#include <network/tsp_graph.h>
+#include <program/program_data.h>
+#include <solver/bc/callbacks/callbacks_helper.h>
+
+#include <ilcplex/ilocplex.h>
+#include <ilcplex/ilocplexi.h>
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// Two-cycle elimination and infeasible subpath rows kept out of the model, when
+// branch_and_cut.lazy_model_rows is set. Both callbacks add the rows which the current
+// solution violates, found by a linear scan of the pool. The pool is shared by the
+// callbacks of all the CPLEX threads, and counts each row the first time it is added.
+class lazy_rows_pool {
+    // Column of variable x_ij, or -1 if arc (i,j) is not in the graph
+    std::vector<std::vector<int>>       arc_column;
+    
+    // Arcs (i,j) with i < j whose reverse arc is also in the graph
+    std::vector<std::pair<int, int>>    two_cycles;
+    std::vector<std::vector<int>>       subpaths;
+    
+    std::vector<std::atomic<bool>>      two_cycle_activated;
+    std::vector<std::atomic<bool>>      subpath_activated;
+    
+    IloRange make_row(const IloEnv& env, const IloNumVarArray& x, const std::vector<int>& nodes, double rhs) const;
+
+public:
+    lazy_rows_pool(const tsp_graph& g, bool two_cycles_elim, bool subpath_elim);
+    
+    lazy_rows_pool(const lazy_rows_pool&) = delete;
+    lazy_rows_pool& operator=(const lazy_rows_pool&) = delete;
+    
+    std::vector<IloRange> separate(const ch::solution& sol, const IloEnv& env, const IloNumVarArray& x, program_data& data);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,205 @@
+#include <solver/bc/callbacks/cuts_callback.h>
+#include <solver/bc/callbacks/cuts_lazy_constraint.h>
+#include <solver/bc/k_opt_solver.h>
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <ratio>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+k_opt_solver::k_opt_solver(tsp_graph& g, const program_params& params, program_data& data, int threads) :
+    g{g},
+    params{params},
+    data{data},
+    gr_with_reverse{g.make_reverse_tsp_graph()},
+    lazy_rows{g, params.bc.lazy_model_rows, params.bc.lazy_model_rows},
+    model{env},
+    cplex{env},
+    variables_x{env},
+    variables_y{env},
+    k_opt_constraint{env, 0.0, IloInfinity, "k_opt_constraint"},
+    last_solution{env}
+{
+    using namespace std::chrono;
+    
+    auto n = g.g[graph_bundle].n;
+    auto Q = g.g[graph_bundle].capacity;
+    auto k_opt = true;
+    
+    // The coefficients of the k-opt constraint are set for each tour in solve()
+    k_opt_lhs = std::vector<std::vector<int>>(2 * n + 2, std::vector<int>(2 * n + 2, 0));
+    
+    IloRangeArray outdegree(env);
+    IloRangeArray indegree(env);
+    IloRangeArray y_upper(env);
+    IloRangeArray y_lower(env);
+    IloRangeArray load(env);
+    IloRange      initial_load(env, 0.0, 0.0, "initial_load");
+    IloRangeArray two_cycles_elimination(env);
+    IloRangeArray subpath_elimination(env);
+    
+    IloObjective obj = IloMinimize(env);
+    
+    auto t_model_start = high_resolution_clock::now();
+    
+    #include <solver/bc/bc_setup_model.raw.cpp>
+    
+    arc_column = std::move(arc_index);
+    
+    model.add(obj);
+    model.add(variables_x);
+    model.add(variables_y);
+    
+    model.add(outdegree);
+    model.add(indegree);
+    model.add(y_upper);
+    model.add(y_lower);
+    model.add(load);
+    model.add(initial_load);
+    model.add(two_cycles_elimination);
+    model.add(subpath_elimination);
+    model.add(k_opt_constraint);
+    
+    cplex.extract(model);
+    
+    cplex.use(cuts_lazy_constraint_handle(env, variables_x, g, gr_with_reverse, data, lazy_rows));
+    cplex.use(cuts_callback_handle(env, variables_x, k_opt, g, gr_with_reverse, params, data, last_solution, lazy_rows));
+    
+    cplex.setParam(IloCplex::Threads, threads);
+    cplex.setParam(IloCplex::Param::Parallel, IloCplex::Opportunistic);
+    
+    if(!DEBUG) {
+        cplex.setOut(env.getNullStream());
+    }
+    
+    auto t_model_end = high_resolution_clock::now();
+    auto model_time_span = duration_cast<duration<double>>(t_model_end - t_model_start);
+    
+    data.time_spent_by_k_opt_heuristics += model_time_span.count();
+    
+    if(DEBUG) {
+        std::cerr << "k_opt_solver.cpp::k_opt_solver() \t Model built in " << model_time_span.count() << " seconds" << std::endl;
+    }
+}
+
+k_opt_solver::~k_opt_solver() {
+    env.end();
+}
+
+// Only the coefficients of the arcs entering or leaving the tour are changed
+void k_opt_solver::set_k_opt_constraint(const path& solution, int k) {
+    auto n = g.g[graph_bundle].n;
+    auto new_lhs = solution.get_x_values(n);
+    
+    IloNumVarArray changed_vars(env);
+    IloNumArray changed_coefs(env);
+    
+    for(auto i = 0; i <= 2 * n + 1; i++) {
+        for(auto j = 0; j <= 2 * n + 1; j++) {
+            if(arc_column[i][j] >= 0 && new_lhs[i][j] != k_opt_lhs[i][j]) {
+                changed_vars.add(variables_x[arc_column[i][j]]);
+                changed_coefs.add(new_lhs[i][j]);
+            }
+        }
+    }
+    
+    k_opt_constraint.setLinearCoefs(changed_vars, changed_coefs);
+    k_opt_constraint.setLB((2 * n) + 1 - k);
+    k_opt_lhs = std::move(new_lhs);
+    
+    changed_coefs.end();
+    changed_vars.end();
+}
+
+// Only the x and y variables of the arcs of the tour are set: CPLEX completes the start
+void k_opt_solver::set_mip_start(const path& solution) {
+    if(cplex.getNMIPStarts() > 0) {
+        cplex.deleteMIPStarts(0, cplex.getNMIPStarts());
+    }
+    
+    IloNumVarArray initial_vars(env);
+    IloNumArray initial_values(env);
+    
+    for(auto l = 0u; l + 1 < solution.path_v.size(); l++) {
+        auto col = arc_column[solution.path_v[l]][solution.path_v[l+1]];
+        initial_vars.add(variables_x[col]);
+        initial_values.add(1);
+        initial_vars.add(variables_y[col]);
+        initial_values.add(solution.load_v[l]);
+    }
+    
+    cplex.addMIPStart(initial_vars, initial_values);
+    
+    initial_values.end();
+    initial_vars.end();
+}
+
+k_opt_solver::result k_opt_solver::solve(const path& solution, int k, double time_limit, long node_limit) {
+    using namespace std::chrono;
+    
+    auto n = g.g[graph_bundle].n;
+    
+    if(!solution.verify_feasible(g)) {
+        std::cerr << "k_opt_solver.cpp::solve() \t I have an unfeasible initial solution!" << std::endl;
+    }
+    
+    data.reset_for_new_branch_and_cut();
+    
+    set_k_opt_constraint(solution, k);
+    set_mip_start(solution);
+    
+    // The cuts callback compares each LP solution with the previous one, which belonged to the last tour
+    last_solution.clear();
+    
+    cplex.setParam(IloCplex::TiLim, time_limit);
+    cplex.setParam(IloCplex::NodeLim, node_limit);
+    
+    auto t_start = high_resolution_clock::now();
+    auto success = cplex.solve();
+    auto t_end = high_resolution_clock::now();
+    auto time_span = duration_cast<duration<double>>(t_end - t_start);
+    
+    data.time_spent_by_k_opt_heuristics += time_span.count();
+    
+    auto status = cplex.getCplexStatus();
+    auto hit_limit = (status == IloCplex::AbortTimeLim || status == IloCplex::NodeLimFeas || status == IloCplex::NodeLimInfeas);
+    
+    if(!success) {
+        if(hit_limit) {
+            return result(solution, true);
+        }
+        
+        std::cerr << "k_opt_solver.cpp::solve() \t CPLEX problem encountered" << std::endl;
+        std::cerr << "k_opt_solver.cpp::solve() \t CPLEX status: " << cplex.getStatus() << std::endl;
+        std::cerr << "k_opt_solver.cpp::solve() \t CPLEX ext status: " << cplex.getCplexStatus() << std::endl;
+        
+        cplex.exportModel("model_err.lp");
+        throw std::runtime_error("Some error occurred or the problem is infeasible");
+    }
+    
+    IloNumArray x(env);
+    auto solution_x = std::vector<std::vector<int>>(2 * n + 2, std::vector<int>(2 * n + 2, 0));
+    
+    cplex.getValues(x, variables_x);
+    
+    for(auto i = 0; i <= 2 * n + 1; i++) {
+        for(auto j = 0; j <= 2 * n + 1; j++) {
+            if(arc_column[i][j] >= 0 && x[arc_column[i][j]] > eps) {
+                solution_x[i][j] = 1;
+            }
+        }
+    }
+    
+    x.end();
+    
+    auto opt_solution_path = path(g, solution_x);
+    
+    if(!opt_solution_path.verify_feasible(g)) {
+        std::cerr << "k_opt_solver.cpp::solve() \t The optimal solution is infeasible!" << std::endl;
+    }
+    
+    return result(std::move(opt_solution_path), hit_limit);
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#ifndef K_OPT_SOLVER_H
+#define K_OPT_SOLVER_H
+
+/*************************************************
+ INCLUDE THIS OR CPLEX WILL PANIC... DRAMA QUEEN!
+*************************************************/
+#include <cstring>
+/************************************************/
+
+#include <network/tsp_graph.h>
+#include <network/path.h>
+#include <parser/program_params.h>
+#include <program/program_data.h>
+#include <solver/bc/callbacks/lazy_rows_pool.h>
+
+#include <ilcplex/ilocplex.h>
+
+#include <utility>
+#include <vector>
+
+// Keeps the k-opt MIP alive between calls: the model is built and extracted once,
+// then for each starting tour only the k-opt constraint and the MIP start change
+class k_opt_solver {
+    tsp_graph&                      g;
+    const program_params&           params;
+    program_data&                   data;
+    tsp_graph                       gr_with_reverse;
+    lazy_rows_pool                  lazy_rows;
+    
+    IloEnv                          env;
+    IloModel                        model;
+    IloCplex                        cplex;
+    IloNumVarArray                  variables_x;
+    IloNumVarArray                  variables_y;
+    IloRange                        k_opt_constraint;
+    IloNumArray                     last_solution;
+    
+    // Column of variable x_ij, or -1 if arc (i,j) is not in the graph
+    std::vector<std::vector<int>>   arc_column;
+    
+    // Current coefficients of the x variables in k_opt_constraint
+    std::vector<std::vector<int>>   k_opt_lhs;
+    
+    static constexpr double eps = 0.00001;
+    
+    void set_k_opt_constraint(const path& solution, int k);
+    void set_mip_start(const path& solution);
+
+public:
+    struct result {
+        path    p;
+        bool    hit_limit; // CPLEX stopped at the time or node limit, before proving optimality
+        
+        result(path p, bool hit_limit) : p{std::move(p)}, hit_limit{hit_limit} {}
+    };
+    
+    k_opt_solver(tsp_graph& g, const program_params& params, program_data& data, int threads);
+    ~k_opt_solver();
+    
+    k_opt_solver(const k_opt_solver&) = delete;
+    k_opt_solver& operator=(const k_opt_solver&) = delete;
+    
+    // Best tour sharing at least 2n+1-k arcs with solution, found within the given limits
+    result solve(const path& solution, int k, double time_limit, long node_limit);
+};
+
+#endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <heuristics/path_scorer.h>
 #include <heuristics/insertion_scorer.h>
 #include <heuristics/request_scorer.h>
+#include <heuristics/savings_heuristic.h>
 
 #include <chrono>
 #include <ctime>
@@ -13,12 +14,12 @@
 #include <iomanip>
 #include <iostream>
 #include <ratio>
+#include <sstream>
+#include <thread>
 
 std::vector<path> heuristic_solver::run_constructive(bool print_output) {
     using namespace std::chrono;
     
-    std::cout << "Heuristic solutions:         \t";
-    
     std::ofstream results_file, summary_file, solutions_file;
     
     if(print_output) {
@@ -26,6 +27,28 @@ std::vector<path> heuristic_solver::run_constructive(bool print_output) {
         results_file << g.g[graph_bundle].instance_name << "\t";
     }
     
+    // The heuristics also run on the mirrored instance, in their own thread and with their own
+    // bookkeeping: its tours are mapped back to this instance once both portfolios are done.
+    // As the two portfolios run concurrently, their time is the wall time up to the join
+    auto mirror_paths = std::vector<path>();
+    auto mirror_output = std::stringstream();
+    auto mirror_thread = std::thread();
+    auto t_start_portfolios = high_resolution_clock::now();
+    auto time_before_portfolios = data.time_spent_by_constructive_heuristics;
+    
+    if(params.ch.use_mirror_instance) {
+        mirror_thread = std::thread([this, &mirror_paths, &mirror_output] () {
+            auto mirror_g = g.make_mirror_tsp_graph();
+            auto mirror_params = params;
+            auto mirror_data = program_data();
+            
+            mirror_params.ch.use_mirror_instance = false;
+            
+            auto mirror_solver = heuristic_solver(mirror_g, mirror_params, mirror_data, mirror_output);
+            mirror_paths = mirror_solver.run_constructive(false);
+        });
+    }
+    
     // Path scorers
     ps_cost_opposite                                                    path_scorer_cost;
     ps_cost_plus_load_opposite                                          path_scorer_cost_plus_load;
@@ -101,6 +124,8 @@ std::vector<path> heuristic_solver::run_constructive(bool print_output) {
         decltype(request_scorer_draught_demand_opp),
         decltype(insertion_scorer_q_cost)>                              tph_8(g, request_scorer_draught_demand_opp, insertion_scorer_q_cost);
     
+    // Savings heuristic
+    savings_heuristic                                                   sav_1(g);
     
     #define TOKENPASTE(x, y) x ## y
     #define TOKENPASTE2(x, y) TOKENPASTE(x, y)
@@ -128,45 +153,67 @@ std::vector<path> heuristic_solver::run_constructive(bool print_output) {
         data.time_spent_by_constructive_heuristics += HEUR_SPAN_TIME(type, number).count(); \
         \
         if(HEUR_RESULT(type, number)) { \
-            std::cout << #type << "_" << #number << ":" << (*HEUR_RESULT(type, number)).total_cost << "\t"; \
+            out << #type << "_" << #number << ":" << (*HEUR_RESULT(type, number)).total_cost << "\t"; \
             if(print_output) { \
                 results_file << (*HEUR_RESULT(type, number)).total_cost << "\t"; \
             } \
             if((*HEUR_RESULT(type, number)).verify_feasible(g)) { \
-                paths.push_back(*HEUR_RESULT(type, number)); \
+                paths.push_back(std::move(*HEUR_RESULT(type, number))); \
             } else { \
-                std::cout << "Generated path is not feasible!" << std::endl; \
-                (*HEUR_RESULT(type, number)).print(std::cout); std::cout << std::endl; \
+                out << "Generated path is not feasible!" << std::endl; \
+                (*HEUR_RESULT(type, number)).print(out); out << std::endl; \
                 if(print_output) { \
                     results_file << "iiii\t"; \
                 } \
             } \
         } else { \
-            std::cout << "xxxx\t"; \
+            out << "xxxx\t"; \
             if(print_output) { \
                 results_file << "xxxx\t"; \
             } \
         }
 
-    EXECUTE_HEURISTIC(oph, 1)
-    EXECUTE_HEURISTIC(oph, 2)
-    EXECUTE_HEURISTIC(oph, 3)
-    EXECUTE_HEURISTIC(oph, 4)
-    EXECUTE_HEURISTIC(oph, 5)
-    EXECUTE_HEURISTIC(oph, 6)
-    EXECUTE_HEURISTIC(oph, 7)
-    EXECUTE_HEURISTIC(oph, 8)
-    
-    EXECUTE_HEURISTIC(tph, 1)
-    EXECUTE_HEURISTIC(tph, 2)
-    EXECUTE_HEURISTIC(tph, 3)
-    EXECUTE_HEURISTIC(tph, 4)
-    EXECUTE_HEURISTIC(tph, 5)
-    EXECUTE_HEURISTIC(tph, 6)
-    EXECUTE_HEURISTIC(tph, 7)
-    EXECUTE_HEURISTIC(tph, 8)
+    // The insertion heuristics are at least cubic: on large instances we only use the savings heuristic
+    if(g.g[graph_bundle].n <= params.ch.insertion_max_requests) {
+        EXECUTE_HEURISTIC(oph, 1)
+        EXECUTE_HEURISTIC(oph, 2)
+        EXECUTE_HEURISTIC(oph, 3)
+        EXECUTE_HEURISTIC(oph, 4)
+        EXECUTE_HEURISTIC(oph, 5)
+        EXECUTE_HEURISTIC(oph, 6)
+        EXECUTE_HEURISTIC(oph, 7)
+        EXECUTE_HEURISTIC(oph, 8)
+    
+        EXECUTE_HEURISTIC(tph, 1)
+        EXECUTE_HEURISTIC(tph, 2)
+        EXECUTE_HEURISTIC(tph, 3)
+        EXECUTE_HEURISTIC(tph, 4)
+        EXECUTE_HEURISTIC(tph, 5)
+        EXECUTE_HEURISTIC(tph, 6)
+        EXECUTE_HEURISTIC(tph, 7)
+        EXECUTE_HEURISTIC(tph, 8)
+    }
     
-    std::cout << std::endl;
+    EXECUTE_HEURISTIC(sav, 1)
+    
+    out << std::endl;
+    
+    if(mirror_thread.joinable()) {
+        mirror_thread.join();
+        
+        out << "Mirror instance solutions:   \t" << mirror_output.str();
+        data.time_spent_by_constructive_heuristics = time_before_portfolios + duration_cast<duration<double>>(high_resolution_clock::now() - t_start_portfolios).count();
+        
+        for(const auto& mirror_path : mirror_paths) {
+            auto p = mirror_path.mirror(g);
+            
+            if(p.verify_feasible(g)) {
+                paths.push_back(std::move(p));
+            } else {
+                std::cerr << "heuristic_solver.cpp::run_constructive() \t Mirrored path is not feasible!" << std::endl;
+            }
+        }
+    }
     
     data.n_constructive_solutions = paths.size();
     
@@ -227,6 +274,12 @@ std::vector<path> heuristic_solver::run_k_opt() {
          std::cout << path.total_cost << "\t";
     }
     std::cout << std::endl;
+    
+    std::cout << "K-opt MIP calls:             \t" << data.k_opt_calls << " (" << data.k_opt_improving_calls << " improving, " << data.k_opt_calls_at_limit << " at limit)";
+    if(data.k_opt_improving_calls > 0) {
+        std::cout << "\t" << data.time_spent_by_improving_k_opt_calls / data.k_opt_improving_calls << " seconds per improvement";
+    }
+    std::cout << std::endl;
 
     paths.insert(paths.end(), k_opt_paths.begin(), k_opt_paths.end());
     
@@ -244,6 +297,7 @@ std::vector<path> heuristic_solver::run_k_opt() {
 std::vector<path> heuristic_solver::run_constructive_heuristics() {
     paths.clear();
     
+    std::cout << "Heuristic solutions:         \t";
     run_constructive(true);
     
     return paths;
@@ -252,6 +306,7 @@ std::vector<path> heuristic_solver::run_constructive_heuristics() {
 std::vector<path> heuristic_solver::run_all_heuristics() {
     paths.clear();
     
+    std::cout << "Heuristic solutions:         \t";
     run_constructive(false);
     run_k_opt();
     
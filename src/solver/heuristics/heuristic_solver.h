@@ -6,6 +6,7 @@
 #include <program/program_data.h>
 #include <parser/program_params.h>
 
+#include <iostream>
 #include <vector>
 
 class heuristic_solver {
@@ -13,12 +14,13 @@ class heuristic_solver {
     const program_params&   params;
     program_data&           data;
     std::vector<path>       paths;
+    std::ostream&           out;
     
     std::vector<path> run_k_opt();
     std::vector<path> run_constructive(bool print_output);
     
 public:
-    heuristic_solver(tsp_graph& g, const program_params& params, program_data& data) : g{g}, params{params}, data{data} {}
+    heuristic_solver(tsp_graph& g, const program_params& params, program_data& data, std::ostream& out = std::cout) : g{g}, params{params}, data{data}, out{out} {}
     std::vector<path> run_constructive_heuristics();
     std::vector<path> run_all_heuristics();
 };
@@ -0,0 +1,286 @@
+#include <heuristics/inserter.h>
+#include <heuristics/insertion_scorer.h>
+#include <heuristics/one_phase_heuristic.h>
+#include <heuristics/path_scorer.h>
+#include <solver/metaheuristics/alns/alns_solver.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+
+alns_solver::alns_solver(tsp_graph& g, const program_params& params, program_data& data, elite_pool& solution_pool) : g{g}, params{params}, data{data}, solution_pool{solution_pool}, gen{params.alns.seed}, max_cost{1}, max_draught{1} {
+    auto n = g.g[graph_bundle].n;
+    
+    for(auto i = 1; i <= 2 * n; i++) {
+        max_draught = std::max(max_draught, g.draught[i]);
+        
+        for(auto j = 1; j <= 2 * n; j++) {
+            max_cost = std::max(max_cost, g.cost[i][j]);
+        }
+    }
+}
+
+path alns_solver::solve() {
+    using namespace std::chrono;
+    
+    auto n = g.g[graph_bundle].n;
+    auto t_start = high_resolution_clock::now();
+    
+    auto elapsed = [&t_start] () {
+        return duration_cast<duration<double>>(high_resolution_clock::now() - t_start).count();
+    };
+    
+    auto initial_solutions = solution_pool.get_solutions();
+    auto current = (initial_solutions.empty() ? path() : *initial_solutions.front());
+    
+    // Without initial solutions, start from the greedy insertion of every request
+    if(current.path_v.empty()) {
+        auto all_requests = std::vector<int>(n);
+        std::iota(all_requests.begin(), all_requests.end(), 1);
+        
+        auto first = repair(path(g, std::vector<int>({0, 2 * n + 1})), all_requests, 0);
+        
+        if(!first) {
+            std::cerr << "alns_solver.cpp::solve() \t Could not build a starting tour" << std::endl;
+            return path();
+        }
+        
+        current = std::move(*first);
+    }
+    
+    auto best = current;
+    auto temperature = params.alns.start_temperature * current.total_cost / std::log(2.0);
+    
+    auto min_removed = std::min(n, std::max(1, params.alns.min_removed_requests));
+    auto max_removed = std::min(n, std::max(min_removed, (int)(params.alns.max_removed_fraction * n)));
+    auto removed_dis = std::uniform_int_distribution<int>(min_removed, max_removed);
+    auto acceptance_dis = std::uniform_real_distribution<double>(0.0, 1.0);
+    
+    auto destroy_weights = std::vector<double>(n_destroy_operators, 1.0);
+    auto destroy_scores = std::vector<double>(n_destroy_operators, 0.0);
+    auto destroy_uses = std::vector<int>(n_destroy_operators, 0);
+    auto repair_weights = std::vector<double>(n_repair_operators, 1.0);
+    auto repair_scores = std::vector<double>(n_repair_operators, 0.0);
+    auto repair_uses = std::vector<int>(n_repair_operators, 0);
+    
+    auto iteration = 0;
+    
+    while(iteration < params.alns.max_iter && elapsed() < params.alns.time_limit) {
+        auto destroy_operator = std::discrete_distribution<int>(destroy_weights.begin(), destroy_weights.end())(gen);
+        auto repair_operator = std::discrete_distribution<int>(repair_weights.begin(), repair_weights.end())(gen);
+        auto n_removed = removed_dis(gen);
+        auto removed = std::vector<int>();
+        
+        if(destroy_operator == 0) {
+            removed = remove_random(current, n_removed);
+        } else if(destroy_operator == 1) {
+            removed = remove_worst(current, n_removed);
+        } else {
+            removed = remove_related(current, n_removed);
+        }
+        
+        auto repaired = repair(current.without_requests(g, removed), removed, repair_operator);
+        auto score = 0.0;
+        
+        if(repaired) {
+            if((*repaired).total_cost < best.total_cost) {
+                score = score_best;
+                best = *repaired;
+                current = std::move(*repaired);
+            } else if((*repaired).total_cost < current.total_cost) {
+                score = score_better;
+                current = std::move(*repaired);
+            } else if(acceptance_dis(gen) < std::exp((current.total_cost - (*repaired).total_cost) / temperature)) {
+                score = score_accepted;
+                current = std::move(*repaired);
+            }
+        }
+        
+        destroy_scores[destroy_operator] += score;
+        destroy_uses[destroy_operator]++;
+        repair_scores[repair_operator] += score;
+        repair_uses[repair_operator]++;
+        
+        temperature *= params.alns.cooling_rate;
+        iteration++;
+        
+        // With a non-positive segment length, the weights keep their initial values
+        if(params.alns.segment_length > 0 && iteration % params.alns.segment_length == 0) {
+            auto update_weights = [this] (std::vector<double>& weights, std::vector<double>& scores, std::vector<int>& uses) {
+                for(auto op = 0u; op < weights.size(); op++) {
+                    if(uses[op] > 0) {
+                        weights[op] = (1 - params.alns.reaction_factor) * weights[op] + params.alns.reaction_factor * scores[op] / uses[op];
+                    }
+                    
+                    // Keep every operator in play
+                    weights[op] = std::max(weights[op], 0.01);
+                    scores[op] = 0.0;
+                    uses[op] = 0;
+                }
+            };
+            
+            update_weights(destroy_weights, destroy_scores, destroy_uses);
+            update_weights(repair_weights, repair_scores, repair_uses);
+        }
+    }
+    
+    data.time_spent_by_alns = elapsed();
+    data.best_alns_solution = best.total_cost;
+    
+    if(!best.verify_feasible(g)) {
+        std::cerr << "alns_solver.cpp::solve() \t The best solution is infeasible!" << std::endl;
+    }
+    
+    std::cout << "ALNS solution:           \t" << best.total_cost << std::endl;
+    std::cout << "Solution obtained in " << data.time_spent_by_alns << " seconds (" << iteration << " iterations)." << std::endl;
+    
+    print_results(best, iteration);
+    solution_pool.offer(best);
+    
+    return best;
+}
+
+std::vector<int> alns_solver::remove_random(const path& p, int n_removed) {
+    auto n = g.g[graph_bundle].n;
+    auto requests = std::vector<int>(n);
+    
+    std::iota(requests.begin(), requests.end(), 1);
+    std::shuffle(requests.begin(), requests.end(), gen);
+    requests.resize(n_removed);
+    
+    return requests;
+}
+
+// Saving of each request is computed on the current tour, as if it were the only one taken out
+std::vector<int> alns_solver::remove_worst(const path& p, int n_removed) {
+    auto n = g.g[graph_bundle].n;
+    auto position = std::vector<int>(2 * n + 2, 0);
+    auto saving = std::vector<int>(n + 1, 0);
+    
+    auto c = [this] (int i, int j) { return std::max(g.cost[i][j], 0); };
+    
+    for(auto l = 0u; l < p.path_v.size(); l++) {
+        position[p.path_v[l]] = l;
+    }
+    
+    for(auto i = 1; i <= n; i++) {
+        auto pi = position[i];
+        auto pd = position[n + i];
+        const auto& v = p.path_v;
+        
+        if(pd == pi + 1) {
+            saving[i] = c(v[pi-1], i) + c(i, n+i) + c(n+i, v[pd+1]) - c(v[pi-1], v[pd+1]);
+        } else {
+            saving[i] = c(v[pi-1], i) + c(i, v[pi+1]) - c(v[pi-1], v[pi+1]) + c(v[pd-1], n+i) + c(n+i, v[pd+1]) - c(v[pd-1], v[pd+1]);
+        }
+    }
+    
+    auto candidates = std::vector<int>(n);
+    auto removed = std::vector<int>();
+    
+    std::iota(candidates.begin(), candidates.end(), 1);
+    std::sort(candidates.begin(), candidates.end(), [&saving] (int i, int j) { return saving[i] > saving[j]; });
+    
+    while((int)removed.size() < n_removed) {
+        auto rank = biased_rank(candidates.size());
+        
+        removed.push_back(candidates[rank]);
+        candidates.erase(candidates.begin() + rank);
+    }
+    
+    return removed;
+}
+
+// Start from a random request, then repeatedly take one of the requests most related to a removed one
+std::vector<int> alns_solver::remove_related(const path& p, int n_removed) {
+    auto n = g.g[graph_bundle].n;
+    auto candidates = std::vector<int>(n);
+    auto removed = std::vector<int>();
+    
+    std::iota(candidates.begin(), candidates.end(), 1);
+    
+    auto first = std::uniform_int_distribution<int>(0, n - 1)(gen);
+    
+    removed.push_back(candidates[first]);
+    candidates.erase(candidates.begin() + first);
+    
+    while((int)removed.size() < n_removed) {
+        auto reference = removed[std::uniform_int_distribution<int>(0, removed.size() - 1)(gen)];
+        
+        std::sort(candidates.begin(), candidates.end(), [this, reference] (int i, int j) { return relatedness(reference, i) < relatedness(reference, j); });
+        
+        auto rank = biased_rank(candidates.size());
+        
+        removed.push_back(candidates[rank]);
+        candidates.erase(candidates.begin() + rank);
+    }
+    
+    return removed;
+}
+
+boost::optional<path> alns_solver::repair(const path& partial, const std::vector<int>& removed, int repair_operator) const {
+    ps_cost_opposite                                                path_scorer_cost;
+    insertion_scorer<decltype(path_scorer_cost)>                    insertion_scorer_cost(path_scorer_cost);
+    
+    auto repaired = boost::optional<path>();
+    
+    if(repair_operator == 0) {
+        normal_inserter<decltype(insertion_scorer_cost)>            inserter_cost(insertion_scorer_cost);
+        one_phase_heuristic<decltype(inserter_cost)>                greedy(g, inserter_cost);
+        
+        repaired = greedy.solve(partial, removed);
+    } else {
+        max_regret_inserter<decltype(insertion_scorer_cost)>        mr_inserter_cost(insertion_scorer_cost);
+        one_phase_heuristic<decltype(mr_inserter_cost)>             regret(g, mr_inserter_cost);
+        
+        repaired = regret.solve(partial, removed);
+    }
+    
+    // The insertion scorer doesn't know about the arcs removed during preprocessing
+    if(repaired && (*repaired).uses_removed_arcs(g)) {
+        return boost::none;
+    }
+    
+    return repaired;
+}
+
+int alns_solver::biased_rank(int size) {
+    auto y = std::uniform_real_distribution<double>(0.0, 1.0)(gen);
+    
+    return std::min(size - 1, (int)(std::pow(y, determinism) * size));
+}
+
+double alns_solver::relatedness(int i, int j) const {
+    auto n = g.g[graph_bundle].n;
+    
+    auto distance = [this] (int from, int to) {
+        if(g.cost[from][to] < 0 && g.cost[to][from] < 0) {
+            return max_cost;
+        }
+        
+        if(g.cost[from][to] < 0 || g.cost[to][from] < 0) {
+            return std::max(g.cost[from][to], g.cost[to][from]);
+        }
+        
+        return std::min(g.cost[from][to], g.cost[to][from]);
+    };
+    
+    return  (double)(distance(i, j) + distance(n + i, n + j)) / max_cost +
+            (double)(std::abs(g.draught[i] - g.draught[j]) + std::abs(g.draught[n + i] - g.draught[n + j])) / max_draught;
+}
+
+void alns_solver::print_results(const path& solution, int iterations) const {
+    std::ofstream results_file;
+    results_file.open(params.alns.results_dir + "results.txt", std::ios::out | std::ios::app);
+    results_file << g.g[graph_bundle].instance_base_name << "\t";
+    results_file << g.g[graph_bundle].n << "\t";
+    results_file << g.g[graph_bundle].h << "\t";
+    results_file << g.g[graph_bundle].k << "\t";
+    results_file << solution.total_cost << "\t";
+    results_file << data.time_spent_by_alns << "\t";
+    results_file << iterations << std::endl;
+    results_file.close();
+}
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef ALNS_SOLVER_H
+#define ALNS_SOLVER_H
+
+#include <network/tsp_graph.h>
+#include <network/path.h>
+#include <parser/program_params.h>
+#include <program/elite_pool.h>
+#include <program/program_data.h>
+
+#include <boost/optional.hpp>
+
+#include <random>
+#include <vector>
+
+// Adaptive Large Neighbourhood Search (Ropke and Pisinger, 2006). At each iteration a destroy
+// operator takes some requests out of the current tour and a repair operator inserts them back,
+// both drawn by roulette wheel with weights that follow how well they did in the last segment of
+// iterations. The new tour replaces the current one according to simulated annealing.
+// Destroy operators: random, worst (largest saving when taken out) and related (close origins
+// and destinations, similar draughts) requests. Repair operators: the one-phase heuristics with
+// the normal and the max-regret inserters.
+class alns_solver {
+    tsp_graph&              g;
+    const program_params&   params;
+    program_data&           data;
+    elite_pool&             solution_pool;
+    std::mt19937            gen;
+    
+    // Normalisation of the two terms of the relatedness
+    int                     max_cost;
+    int                     max_draught;
+    
+    static constexpr int n_destroy_operators = 3;
+    static constexpr int n_repair_operators = 2;
+    
+    // Scores of the operators which produce a new best tour, a tour better than the current one, or an accepted worse tour
+    static constexpr double score_best = 33.0;
+    static constexpr double score_better = 9.0;
+    static constexpr double score_accepted = 13.0;
+    
+    // Worst and related removals pick the request ranked floor(y^determinism * size) with y uniform in [0,1)
+    static constexpr double determinism = 3.0;
+    
+    std::vector<int> remove_random(const path& p, int n_removed);
+    std::vector<int> remove_worst(const path& p, int n_removed);
+    std::vector<int> remove_related(const path& p, int n_removed);
+    boost::optional<path> repair(const path& partial, const std::vector<int>& removed, int repair_operator) const;
+    
+    // Rank of a request among the sorted candidates, biased towards the first ones
+    int biased_rank(int size);
+    
+    // The lower, the more related: requests sharing ports have distance 0
+    double relatedness(int i, int j) const;
+    
+    void print_results(const path& solution, int iterations) const;
+
+public:
+    // Starts from the best tour of the solution pool and publishes its best tour to it
+    alns_solver(tsp_graph& g, const program_params& params, program_data& data, elite_pool& solution_pool);
+    path solve();
+};
+
+#endif
\ No newline at end of file
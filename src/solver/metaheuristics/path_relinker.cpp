@@ -0,0 +1,95 @@
+#include <solver/metaheuristics/path_relinker.h>
+
+#include <algorithm>
+
+path path_relinker::relink(const path& from, const path& to, std::chrono::high_resolution_clock::time_point deadline) const {
+    auto n = g.g[graph_bundle].n;
+    auto size = to.path_v.size();
+    auto guide_position = std::vector<int>(2 * n + 2, 0);
+    auto moved = std::vector<bool>(n + 1, false);
+    auto current = from;
+    auto best = path();
+    auto walk = std::vector<path>();
+    
+    for(auto l = 0u; l < size; l++) {
+        guide_position[to.path_v[l]] = l;
+    }
+    
+    while(current.path_v != to.path_v && std::chrono::high_resolution_clock::now() < deadline) {
+        auto best_step = path();
+        auto best_request = 0;
+        
+        for(auto r = 1; r <= n; r++) {
+            if(moved[r]) {
+                continue;
+            }
+            
+            auto nodes = std::vector<int>();
+            
+            nodes.reserve(size);
+            
+            for(auto j : current.path_v) {
+                if(j != r && j != n + r) {
+                    nodes.push_back(j);
+                }
+            }
+            
+            // The origin comes first in the guiding tour, so inserting it first leaves both at their guiding positions
+            nodes.insert(nodes.begin() + guide_position[r], r);
+            nodes.insert(nodes.begin() + guide_position[n + r], n + r);
+            
+            if(nodes == current.path_v || !feasible(nodes)) {
+                continue;
+            }
+            
+            auto step = path(g, nodes);
+            
+            if(best_step.path_v.empty() || step.total_cost < best_step.total_cost) {
+                best_step = std::move(step);
+                best_request = r;
+            }
+        }
+        
+        if(best_step.path_v.empty()) {
+            break;
+        }
+        
+        moved[best_request] = true;
+        current = std::move(best_step);
+        
+        if(current.path_v != to.path_v) {
+            walk.push_back(current);
+        }
+    }
+    
+    // Tours next to either end tend to fall back into it: only the middle half of the walk is considered
+    auto first = walk.size() / 4;
+    auto last = walk.size() - walk.size() / 4;
+    
+    for(auto step = first; step < last; step++) {
+        if(best.path_v.empty() || walk[step].total_cost < best.total_cost) {
+            best = walk[step];
+        }
+    }
+    
+    return best;
+}
+
+// Precedences are kept by construction: only loads, draughts and removed arcs need checking
+bool path_relinker::feasible(const std::vector<int>& nodes) const {
+    auto Q = g.g[graph_bundle].capacity;
+    auto load = 0;
+    
+    for(auto l = 0u; l < nodes.size() - 1; l++) {
+        auto i = nodes[l];
+        auto j = nodes[l+1];
+        
+        load += g.demand[i];
+        
+        if(g.cost[i][j] < 0 || load > std::min({Q, g.draught[i], g.draught[j]})) {
+            return false;
+        }
+    }
+    
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef PATH_RELINKER_H
+#define PATH_RELINKER_H
+
+#include <network/tsp_graph.h>
+#include <network/path.h>
+
+#include <chrono>
+#include <vector>
+
+// Path relinking (Glover, 1997) between two tours of the same instance. Each step takes one
+// request out of the current tour and puts its origin and destination where the guiding tour
+// has them. Among the requests not moved yet, the one giving the cheapest feasible tour is
+// chosen, so the walk takes at most n steps.
+class path_relinker {
+    const tsp_graph& g;
+    
+    bool feasible(const std::vector<int>& nodes) const;
+
+public:
+    path_relinker(const tsp_graph& g) : g{g} {}
+    
+    // Best tour strictly between from and to, or an empty path if the walk found none
+    path relink(const path& from, const path& to, std::chrono::high_resolution_clock::time_point deadline) const;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <solver/metaheuristics/progress_sink.h>
+
+#include <iostream>
+
+progress_sink::progress_sink(const std::string& file_name) : t_start{std::chrono::high_resolution_clock::now()} {
+    if(file_name.empty()) {
+        return;
+    }
+    
+    file.open(file_name, std::ios::out | std::ios::trunc);
+    
+    if(!file.is_open()) {
+        std::cerr << "progress_sink.cpp::progress_sink() \t Cannot write progress to " << file_name << std::endl;
+        return;
+    }
+    
+    file << "search\titeration\ttime\tcurrent\tbest\tscan_size" << std::endl;
+}
+
+void progress_sink::record(int search_id, int iteration, int current_cost, int best_cost, long scan_size) {
+    if(!enabled()) {
+        return;
+    }
+    
+    auto elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::high_resolution_clock::now() - t_start).count();
+    
+    std::lock_guard<std::mutex> guard(mtx);
+    
+    // Flushed at every record, so that the file can be followed while the searches run
+    file << search_id << "\t" << iteration << "\t" << elapsed << "\t" << current_cost << "\t" << best_cost << "\t" << scan_size << std::endl;
+}
\ No newline at end of file
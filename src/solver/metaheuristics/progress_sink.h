@@ -0,0 +1,25 @@
+#ifndef PROGRESS_SINK_H
+#define PROGRESS_SINK_H
+
+#include <chrono>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+// Progress records of searches running in parallel, written to a tab-separated file as they come:
+// search id, iteration, seconds since the sink was opened, current cost, best cost and 3-opt moves
+// evaluated by the last iteration.
+// A sink built with an empty file name records nothing.
+class progress_sink {
+    std::ofstream                                   file;
+    std::mutex                                      mtx;
+    std::chrono::high_resolution_clock::time_point  t_start;
+
+public:
+    progress_sink(const std::string& file_name);
+    
+    bool enabled() const { return file.is_open(); }
+    void record(int search_id, int iteration, int current_cost, int best_cost, long scan_size);
+};
+
+#endif
\ No newline at end of file
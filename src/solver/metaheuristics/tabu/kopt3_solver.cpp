@@ -1,115 +1,477 @@
 #include <solver/metaheuristics/tabu/kopt3_solver.h>
 
-#include <boost/optional.hpp>
-
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <numeric>
 #include <stdexcept>
 
-tabu_solver::tabu_and_non_tabu_solutions kopt3_solver::solve(const path& starting_solution, const std::vector<tabu_solver::tabu_move>& tabu_moves) {
-    auto i = std::vector<int>(3);
-    auto j = std::vector<int>(3);
-    
-    auto new_shortest_path_overall = path();
-    auto new_shortest_path_halal = path(); // Halal = non-tabu
-    auto new_tabu_move_overall = tabu_solver::tabu_move();
-    auto new_tabu_move_halal = tabu_solver::tabu_move(); // Halal = non-tabu
-    auto overall_sol_found = false;
-    auto halal_sol_found = false;
+kopt3_solver::kopt3_solver(tsp_graph& g, int candidate_list_size, int scan_threads, const std::string& scan_policy, int scan_sample_size, unsigned int seed) : g{g}, candidate_list_size{candidate_list_size}, scan_threads{scan_threads}, job{nullptr}, job_number{0}, workers_busy{0}, stopping{false}, scan_policy{scan_policy}, scan_sample_size{scan_sample_size}, gen{seed}, scan_size{0} {
+    if(scan_policy != "full" && scan_policy != "first" && scan_policy != "sample") {
+        std::cerr << "kopt3_solver.cpp::kopt3_solver() \t Unknown scan policy " << scan_policy << ", using the full scan" << std::endl;
+        this->scan_policy = "full";
+    }
+    
+    // The first improvement scan runs on a single thread
+    if(this->scan_policy != "first") {
+        for(auto t = 1; t < scan_threads; t++) {
+            workers.push_back(std::thread(&kopt3_solver::worker_loop, this, t));
+        }
+    }
+    
+    if(candidate_list_size <= 0) {
+        return;
+    }
+    
+    auto n = g.g[graph_bundle].n;
+    
+    candidates = std::vector<std::vector<int>>(2 * n + 2);
+    
+    // Arcs removed during preprocessing have cost -1 and never enter the lists
+    for(auto i = 0; i <= 2 * n + 1; i++) {
+        auto successors = std::vector<int>();
+        
+        for(auto j = 0; j <= 2 * n + 1; j++) {
+            if(g.cost[i][j] >= 0) {
+                successors.push_back(j);
+            }
+        }
+        
+        auto list_size = std::min((int)successors.size(), candidate_list_size);
+        
+        std::partial_sort(successors.begin(), successors.begin() + list_size, successors.end(),
+            [&g, i] (int j1, int j2) {
+                return (g.cost[i][j1] < g.cost[i][j2] || (g.cost[i][j1] == g.cost[i][j2] && j1 < j2));
+            }
+        );
+        
+        candidates[i].assign(successors.begin(), successors.begin() + list_size);
+    }
+    
+    dont_look = std::vector<char>(2 * n + 2, false);
+    last_successor = std::vector<int>(2 * n + 2, -1);
+    min_slack_from = std::vector<std::vector<int>>(std::max(1, scan_threads), std::vector<int>(2 * n + 2));
+}
+
+kopt3_solver::~kopt3_solver() {
+    {
+        std::lock_guard<std::mutex> guard(workers_mutex);
+        stopping = true;
+    }
+    
+    job_ready.notify_all();
+    
+    for(auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void kopt3_solver::worker_loop(int t) {
+    auto last_job_number = 0l;
+    
+    while(true) {
+        std::unique_lock<std::mutex> lock(workers_mutex);
+        
+        job_ready.wait(lock, [this, last_job_number] { return stopping || job_number != last_job_number; });
+        
+        if(stopping) {
+            return;
+        }
+        
+        last_job_number = job_number;
+        lock.unlock();
+        
+        (*job)(t);
+        
+        lock.lock();
+        
+        if(--workers_busy == 0) {
+            job_done.notify_one();
+        }
+    }
+}
+
+void kopt3_solver::run_scan_job(const std::function<void(int)>& scan_job) {
+    {
+        std::lock_guard<std::mutex> guard(workers_mutex);
+        job = &scan_job;
+        job_number++;
+        workers_busy = workers.size();
+    }
+    
+    job_ready.notify_all();
+    
+    scan_job(0);
+    
+    std::unique_lock<std::mutex> lock(workers_mutex);
+    
+    job_done.wait(lock, [this] { return workers_busy == 0; });
+    job = nullptr;
+}
+
+// Both ends of every arc which was not in the tour seen by the last call get looked at again
+void kopt3_solver::update_dont_look_bits(const path& p) {
+    for(auto l = 0u; l < p.path_v.size() - 1; l++) {
+        if(last_successor[p.path_v[l]] != p.path_v[l+1]) {
+            dont_look[p.path_v[l]] = false;
+            dont_look[p.path_v[l+1]] = false;
+            last_successor[p.path_v[l]] = p.path_v[l+1];
+        }
+    }
+}
 
-    for(auto _i0 = 0u; _i0 < starting_solution.path_v.size() - 3; _i0++) {
-        i[0] = starting_solution.path_v.at(_i0);
-        j[0] = starting_solution.path_v.at(_i0 + 1);
+// The move removes the arcs leaving positions _i0 < _i1 < _i2 and swaps the two segments
+// between them: seg1 = (_i0, _i1] and seg2 = (_i1, _i2]. A move is feasible if:
+// - seg2 doesn't contain the destination of a request whose origin is in seg1;
+// - the arcs of seg2 can do without the demand of seg1, and those of seg1 can take the
+//   demand of seg2, i.e. their minimum slack is large enough;
+// - the three new arcs can take their load.
+// So each move is evaluated in O(1), and only the chosen ones are built.
+tabu_solver::tabu_and_non_tabu_solutions kopt3_solver::solve(const path& starting_solution, const tabu_list& tabu) {
+    auto n = g.g[graph_bundle].n;
+    auto Q = g.g[graph_bundle].capacity;
+    const auto& p = starting_solution.path_v;
+    const auto& load = starting_solution.load_v;
+    auto size = (int)p.size();
+    
+    auto capacity = [this, Q] (int from, int to) { return std::min({Q, g.draught[from], g.draught[to]}); };
+    
+    // Slack of the arc leaving each position, and position of the origin of each destination
+    auto slack = std::vector<int>(size, 0);
+    auto origin_position = std::vector<int>(size, -1);
+    auto position = std::vector<int>(2 * n + 2, 0);
+    
+    for(auto l = 0; l < size; l++) {
+        position[p[l]] = l;
+    }
+    
+    for(auto l = 0; l < size - 1; l++) {
+        slack[l] = capacity(p[l], p[l+1]) - load[l];
+        
+        if(p[l] > n && p[l] <= 2 * n) {
+            origin_position[l] = position[p[l] - n];
+        }
+    }
+    
+    // Record a feasible move, if it is the best so far overall or among the non-tabu ones
+    auto consider = [&] (best_moves& best, int _i0, int _i1, int _i2, int new_cost) {
+        int i[] = {p[_i0], p[_i1], p[_i2]};
+        int j[] = {p[_i0 + 1], p[_i1 + 1], p[_i2 + 1]};
+        
+        auto shortest_id = 0;
+        
+        if(g.cost[i[1]][j[1]] < g.cost[i[0]][j[0]]) {
+            shortest_id = 1;
+        }
+        
+        if(g.cost[i[2]][j[2]] < g.cost[i[1]][j[1]]) {
+            shortest_id = 2;
+        }
+        
+        auto is_tabu = tabu.is_tabu(i[shortest_id], j[shortest_id]);
         
-        for(auto _i1 = _i0 + 1; _i1 < starting_solution.path_v.size() - 2; _i1++) {
-            i[1] = starting_solution.path_v.at(_i1);
-            j[1] = starting_solution.path_v.at(_i1 + 1);
+        auto new_overall = (!best.overall_found || new_cost < best.cost_overall);
+        auto new_halal = (!is_tabu && (!best.halal_found || new_cost < best.cost_halal));
+        
+        if(new_overall || new_halal) {
+            auto move = tabu_solver::tabu_move(std::make_pair(i[shortest_id], j[shortest_id]), g.cost[i[shortest_id]][j[shortest_id]]);
             
-            for(auto _i2 = _i1 + 1; _i2 < starting_solution.path_v.size() - 1; _i2++) {
-                i[2] = starting_solution.path_v.at(_i2);
-                j[2] = starting_solution.path_v.at(_i2 + 1);
-                
-                auto shortest_id = 0;
+            if(new_overall) {
+                best.overall_found = true;
+                best.cost_overall = new_cost;
+                best.move_overall = {_i0, _i1, _i2};
+                best.tabu_move_overall = move;
+            }
+            
+            if(new_halal) {
+                best.halal_found = true;
+                best.cost_halal = new_cost;
+                best.move_halal = {_i0, _i1, _i2};
+                best.tabu_move_halal = move;
+            }
+        }
+    };
+    
+    auto move_cost = [&] (int _i0, int _i1, int _i2) {
+        return starting_solution.total_cost
+            - g.cost[p[_i0]][p[_i0 + 1]] - g.cost[p[_i1]][p[_i1 + 1]] - g.cost[p[_i2]][p[_i2 + 1]]
+            + g.cost[p[_i0]][p[_i1 + 1]] + g.cost[p[_i1]][p[_i2 + 1]] + g.cost[p[_i2]][p[_i0 + 1]];
+    };
+    
+    // Loads of a move which keeps the precedences, given the minimum slacks of its two segments
+    auto loads_fit = [&] (int _i0, int _i1, int _i2, int min_slack_seg1, int min_slack_seg2) {
+        auto seg1_demand = load[_i1] - load[_i0];
+        auto seg2_demand = load[_i2] - load[_i1];
+        
+        return !(   load[_i0] > capacity(p[_i0], p[_i1 + 1]) ||
+                    min_slack_seg2 < -seg1_demand ||
+                    load[_i0] + seg2_demand > capacity(p[_i2], p[_i0 + 1]) ||
+                    min_slack_seg1 < seg2_demand ||
+                    load[_i2] > capacity(p[_i1], p[_i2 + 1])
+        );
+    };
+    
+    // Scan every seg2 following seg1 = (_i0, _i1]. Minimum slacks are kept up to date as the loop
+    // extends seg2, and precedence breaks for every seg2 longer than the first one that contains
+    // a destination with its origin in seg1. Returns true if any of the moves improves the tour.
+    auto scan_seg2 = [&] (best_moves& best, int _i0, int _i1, int min_slack_seg1) {
+        auto improving = false;
+        auto min_slack_seg2 = std::numeric_limits<int>::max();
+        
+        for(auto _i2 = _i1 + 1; _i2 < size - 1; _i2++) {
+            if(origin_position[_i2] > _i0 && origin_position[_i2] <= _i1) {
+                break;
+            }
+            
+            best.scanned++;
+            
+            if(_i2 - 1 > _i1) {
+                min_slack_seg2 = std::min(min_slack_seg2, slack[_i2 - 1]);
+            }
+            
+            if(!loads_fit(_i0, _i1, _i2, min_slack_seg1, min_slack_seg2)) {
+                continue;
+            }
+            
+            auto new_cost = move_cost(_i0, _i1, _i2);
+            
+            if(new_cost < starting_solution.total_cost) {
+                improving = true;
+            }
+            
+            consider(best, _i0, _i1, _i2, new_cost);
+        }
+        
+        return improving;
+    };
+    
+    // Scan the moves starting from each _i0 with scan_from(_i0, best, t), t being the thread.
+    // On several threads, each one gets a contiguous range of _i0 with about the same number of
+    // moves, i.e. of pairs (_i1, _i2) following _i0. Merging the ranges in order then gives the
+    // same moves as the sequential scan, and so the same trajectory of the tabu search.
+    auto scan = [&] (const auto& scan_from) {
+        auto n_threads = std::max(1, std::min((int)workers.size() + 1, size - 3));
+        
+        if(n_threads == 1) {
+            auto best = best_moves();
+            
+            for(auto _i0 = 0; _i0 < size - 3; _i0++) {
+                scan_from(_i0, best, 0);
+            }
+            
+            return best;
+        }
+        
+        auto moves_from = [size] (int _i0) { return (double)(size - _i0) * (size - _i0); };
+        auto total_moves = 0.0;
+        
+        for(auto _i0 = 0; _i0 < size - 3; _i0++) {
+            total_moves += moves_from(_i0);
+        }
+        
+        auto first_i0 = std::vector<int>(1, 0);
+        auto moves = 0.0;
+        
+        for(auto _i0 = 0; _i0 < size - 3 && (int)first_i0.size() < n_threads; _i0++) {
+            moves += moves_from(_i0);
+            
+            if(moves >= total_moves * first_i0.size() / n_threads) {
+                first_i0.push_back(_i0 + 1);
+            }
+        }
+        
+        first_i0.resize(n_threads, size - 3);
+        first_i0.push_back(size - 3);
+        
+        auto thread_best = std::vector<best_moves>(n_threads);
+        
+        run_scan_job(
+            [&] (int t) {
+                // Workers beyond n_threads have nothing to scan on short tours
+                if(t >= n_threads) {
+                    return;
+                }
                 
-                if(g.cost[i[1]][j[1]] < g.cost[i[0]][j[0]]) {
-                    shortest_id = 1;
+                for(auto _i0 = first_i0[t]; _i0 < first_i0[t + 1]; _i0++) {
+                    scan_from(_i0, thread_best[t], t);
                 }
+            }
+        );
+        
+        auto best = thread_best[0];
+        
+        for(auto t = 1; t < n_threads; t++) {
+            best.merge(thread_best[t]);
+        }
+        
+        return best;
+    };
+    
+    // First improvement: positions _i0 in random order, until one of them gives an improving
+    // non-tabu move. Improving tabu moves met before are still returned, for the aspiration.
+    auto scan_first = [&] (const auto& scan_from) {
+        auto best = best_moves();
+        auto order = std::vector<int>(std::max(0, size - 3));
+        
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), gen);
+        
+        for(auto _i0 : order) {
+            scan_from(_i0, best, 0);
+            
+            if(best.halal_found && best.cost_halal < starting_solution.total_cost) {
+                break;
+            }
+        }
+        
+        return best;
+    };
+    
+    auto scan_by_policy = [&] (const auto& scan_from) {
+        return (scan_policy == "first" ? scan_first(scan_from) : scan(scan_from));
+    };
+    
+    // Random moves drawn as in tabu_solver::perturb. Without the incremental scan, checking
+    // a move takes the length of its segments.
+    auto scan_sample = [&] () {
+        auto best = best_moves();
+        
+        if(size < 4) {
+            return best;
+        }
+        
+        auto dis = std::uniform_int_distribution<int>(0, size - 2);
+        
+        for(auto sample = 0; sample < scan_sample_size; sample++) {
+            int positions[] = {dis(gen), dis(gen), dis(gen)};
+            
+            std::sort(positions, positions + 3);
+            
+            if(positions[0] == positions[1] || positions[1] == positions[2]) {
+                continue;
+            }
+            
+            auto _i0 = positions[0];
+            auto _i1 = positions[1];
+            auto _i2 = positions[2];
+            auto min_slack_seg1 = std::numeric_limits<int>::max();
+            auto min_slack_seg2 = std::numeric_limits<int>::max();
+            auto precedence = true;
+            
+            best.scanned++;
+            
+            for(auto l = _i0 + 1; l < _i1; l++) {
+                min_slack_seg1 = std::min(min_slack_seg1, slack[l]);
+            }
+            
+            for(auto l = _i1 + 1; l <= _i2 && precedence; l++) {
+                precedence = (origin_position[l] <= _i0 || origin_position[l] > _i1);
                 
-                if(g.cost[i[2]][j[2]] < g.cost[i[1]][j[1]]) {
-                    shortest_id = 2;
+                if(l < _i2) {
+                    min_slack_seg2 = std::min(min_slack_seg2, slack[l]);
                 }
+            }
+            
+            if(precedence && loads_fit(_i0, _i1, _i2, min_slack_seg1, min_slack_seg2)) {
+                consider(best, _i0, _i1, _i2, move_cost(_i0, _i1, _i2));
+            }
+        }
+        
+        return best;
+    };
+    
+    auto chosen = best_moves();
+    
+    if(scan_policy == "sample") {
+        chosen = scan_sample();
+    } else if(candidate_list_size > 0) {
+        update_dont_look_bits(starting_solution);
+        
+        auto dont_look_clear = std::none_of(dont_look.begin(), dont_look.end(), [] (char bit) { return bit; });
+        
+        auto scan_candidates_from = [&] (int _i0, best_moves& best, int t) {
+            if(dont_look[p[_i0]]) {
+                return;
+            }
+            
+            // min_slack[l] = minimum slack of the arcs leaving positions _i0+1 to l
+            auto& min_slack = min_slack_from[t];
+            
+            for(auto l = _i0 + 1; l < size - 1; l++) {
+                min_slack[l] = std::min(slack[l], (l > _i0 + 1 ? min_slack[l - 1] : std::numeric_limits<int>::max()));
+            }
+            
+            auto improving = false;
+            
+            for(auto j1 : candidates[p[_i0]]) {
+                auto _i1 = position[j1] - 1;
                 
-                auto is_tabu = false;
-
-                for(const auto& move : tabu_moves) {
-                    if(
-                        (move.vertices.first == i[shortest_id] && move.vertices.second == j[shortest_id]) ||
-                        (move.vertices.first == j[shortest_id] && move.vertices.second == i[shortest_id])
-                    ) {
-                        is_tabu = true;
+                if(_i1 > _i0 && _i1 < size - 2) {
+                    auto min_slack_seg1 = (_i1 - 1 > _i0 ? min_slack[_i1 - 1] : std::numeric_limits<int>::max());
+                    
+                    if(scan_seg2(best, _i0, _i1, min_slack_seg1)) {
+                        improving = true;
                     }
                 }
-
-                auto new_path = exec_3opt(starting_solution, i, j);
+            }
+            
+            if(!improving) {
+                dont_look[p[_i0]] = true;
+            }
+        };
+        
+        chosen = scan_by_policy(scan_candidates_from);
+        
+        // Don't-look bits only speed up descents: at a local optimum, the tabu step needs
+        // the best non-improving move of the whole granular neighbourhood. Unless the first
+        // scan already covered it, scan it again without bits. The bits are then left clear,
+        // so that the next tabu step covers it with a single scan
+        if(!chosen.overall_found || chosen.cost_overall >= starting_solution.total_cost) {
+            if(!dont_look_clear) {
+                std::fill(dont_look.begin(), dont_look.end(), false);
+                chosen.merge(scan_by_policy(scan_candidates_from));
+            }
+            
+            std::fill(dont_look.begin(), dont_look.end(), false);
+        }
+    }
+    
+    // Full neighbourhood: also used when no candidate or sampled move is feasible
+    if(!chosen.overall_found) {
+        chosen.merge(scan_by_policy(
+            [&] (int _i0, best_moves& best, int) {
+                auto min_slack_seg1 = std::numeric_limits<int>::max();
                 
-                if(new_path) {
-                    if(!overall_sol_found) {
-                        overall_sol_found = true;
-                        new_shortest_path_overall = *new_path;
-                        new_tabu_move_overall = tabu_solver::tabu_move(std::make_pair(i[shortest_id], j[shortest_id]), g.cost[i[shortest_id]][j[shortest_id]]);
-                    } else {
-                        if((*new_path).total_cost < new_shortest_path_overall.total_cost) {
-                            new_shortest_path_overall = *new_path;
-                            new_tabu_move_overall = tabu_solver::tabu_move(std::make_pair(i[shortest_id], j[shortest_id]), g.cost[i[shortest_id]][j[shortest_id]]);
-                        }
-                    }
-
-                    if(!is_tabu) {
-                        if(!halal_sol_found) {
-                            halal_sol_found = true;
-                            new_shortest_path_halal = *new_path;
-                            new_tabu_move_halal = tabu_solver::tabu_move(std::make_pair(i[shortest_id], j[shortest_id]), g.cost[i[shortest_id]][j[shortest_id]]);
-                        } else {
-                            if((*new_path).total_cost < new_shortest_path_halal.total_cost) {
-                                new_shortest_path_halal = *new_path;
-                                new_tabu_move_halal = tabu_solver::tabu_move(std::make_pair(i[shortest_id], j[shortest_id]), g.cost[i[shortest_id]][j[shortest_id]]);
-                            }
-                        }
+                for(auto _i1 = _i0 + 1; _i1 < size - 2; _i1++) {
+                    if(_i1 - 1 > _i0) {
+                        min_slack_seg1 = std::min(min_slack_seg1, slack[_i1 - 1]);
                     }
+                    
+                    scan_seg2(best, _i0, _i1, min_slack_seg1);
                 }
             }
-        }
+        ));
     }
     
+    scan_size = chosen.scanned;
+    
+    auto new_shortest_path_overall = (chosen.overall_found ? apply_3opt(starting_solution, chosen.move_overall) : path());
+    auto new_shortest_path_halal = (chosen.halal_found ? apply_3opt(starting_solution, chosen.move_halal) : path());
+    
     return tabu_solver::tabu_and_non_tabu_solutions(
-            std::move(tabu_solver::tabu_result(std::move(new_shortest_path_overall), std::move(new_tabu_move_overall))),
-            std::move(tabu_solver::tabu_result(std::move(new_shortest_path_halal), std::move(new_tabu_move_halal)))
+            tabu_solver::tabu_result(std::move(new_shortest_path_overall), std::move(chosen.tabu_move_overall)),
+            tabu_solver::tabu_result(std::move(new_shortest_path_halal), std::move(chosen.tabu_move_halal))
     );
 }
 
-boost::optional<path> kopt3_solver::exec_3opt(const path& p, const std::vector<int>& i, const std::vector<int>& j) {
-    auto n = g.g[graph_bundle].n;
-    auto p_x = p.get_x_values(n);
-    
-    for(auto n = 0; n <= 2; n++) {
-        p_x[i[n]][j[n]] = 0;
-    }
-    
-    if(j[1] > n && ((j[0] <= n && j[0] + n == j[1]) || (i[1] <= n && i[1] + n == j[1]))) {
-        return boost::none;
-    }
+path kopt3_solver::apply_3opt(const path& p, const std::vector<int>& positions) const {
+    auto nodes = std::vector<int>();
     
-    if(i[2] > n && ((j[0] <= n && j[0] + n == i[2]) || (i[1] <= n && i[1] + n == i[2]))) {
-        return boost::none;
-    }
-    
-    p_x[i[0]][j[1]] = 1;
-    p_x[i[1]][j[2]] = 1;
-    p_x[i[2]][j[0]] = 1;
-    
-    auto new_path = path(g, p_x);
-    
-    if(!new_path.verify_feasible(g)) {
-        return boost::none;
-    }
+    nodes.reserve(p.path_v.size());
+    nodes.insert(nodes.end(), p.path_v.begin(), p.path_v.begin() + positions[0] + 1);
+    nodes.insert(nodes.end(), p.path_v.begin() + positions[1] + 1, p.path_v.begin() + positions[2] + 1);
+    nodes.insert(nodes.end(), p.path_v.begin() + positions[0] + 1, p.path_v.begin() + positions[1] + 1);
+    nodes.insert(nodes.end(), p.path_v.begin() + positions[2] + 1, p.path_v.end());
     
-    return new_path;
+    return path(g, nodes);
 }
\ No newline at end of file
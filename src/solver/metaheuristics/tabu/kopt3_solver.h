@@ -3,19 +3,109 @@
 
 #include <network/tsp_graph.h>
 #include <network/path.h>
+#include <solver/metaheuristics/tabu/tabu_list.h>
 #include <solver/metaheuristics/tabu/tabu_solver.h>
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
 class kopt3_solver {
     tsp_graph& g;
     
-    boost::optional<path> exec_3opt(const path& p, const std::vector<int>& i, const std::vector<int>& j);
+    // Granular neighbourhood: when candidate_list_size > 0, a move is only generated if its
+    // first new arc goes from a node to one of its candidate_list_size cheapest successors
+    int                             candidate_list_size;
+    std::vector<std::vector<int>>   candidates;
     
+    // Don't-look bits: a node whose moves didn't improve the tour is not used to start
+    // a move again, until one of its arcs changes. Not a vector<bool>, as scan threads
+    // set the bits of different nodes at the same time
+    std::vector<char>               dont_look;
+    std::vector<int>                last_successor;
+    
+    // For each scan thread, the minimum slacks of the arcs from the position after _i0 onwards
+    std::vector<std::vector<int>>   min_slack_from;
+    
+    // Each thread scans the moves starting from a contiguous range of positions
+    int                             scan_threads;
+    
+    // Scan threads 1 to scan_threads - 1 are started once by the constructor, and wait for the
+    // job of each scan: run_scan_job() gives it to them, runs it as thread 0 and waits for them
+    std::vector<std::thread>        workers;
+    std::mutex                      workers_mutex;
+    std::condition_variable         job_ready;
+    std::condition_variable         job_done;
+    const std::function<void(int)>* job;
+    long                            job_number;
+    int                             workers_busy;
+    bool                            stopping;
+    
+    void worker_loop(int t);
+    void run_scan_job(const std::function<void(int)>& scan_job);
+    
+    // Scan policy: "full" takes the best move of the neighbourhood; "first" scans the moves starting
+    // from each position in random order, and stops after the first position giving an improving
+    // non-tabu move; "sample" takes the best of scan_sample_size random moves, and falls back to the
+    // full scan when none of them is feasible. Only the full scans use scan_threads
+    std::string                     scan_policy;
+    int                             scan_sample_size;
+    std::mt19937                    gen;
+    
+    // Moves evaluated by the last call to solve()
+    long                            scan_size;
+    
+    // Best move overall and best non-tabu (halal) move found by a scan, as positions _i0 < _i1 < _i2
+    struct best_moves {
+        int                     cost_overall;
+        int                     cost_halal;
+        std::vector<int>        move_overall;
+        std::vector<int>        move_halal;
+        tabu_solver::tabu_move  tabu_move_overall;
+        tabu_solver::tabu_move  tabu_move_halal;
+        bool                    overall_found;
+        bool                    halal_found;
+        long                    scanned;
+        
+        best_moves() : cost_overall{0}, cost_halal{0}, move_overall(3), move_halal(3), overall_found{false}, halal_found{false}, scanned{0} {}
+        
+        // Moves of a scan which comes later replace the current ones only if strictly better
+        void merge(const best_moves& later) {
+            scanned += later.scanned;
+            
+            if(later.overall_found && (!overall_found || later.cost_overall < cost_overall)) {
+                cost_overall = later.cost_overall;
+                move_overall = later.move_overall;
+                tabu_move_overall = later.tabu_move_overall;
+                overall_found = true;
+            }
+            
+            if(later.halal_found && (!halal_found || later.cost_halal < cost_halal)) {
+                cost_halal = later.cost_halal;
+                move_halal = later.move_halal;
+                tabu_move_halal = later.tabu_move_halal;
+                halal_found = true;
+            }
+        }
+    };
+    
+    void update_dont_look_bits(const path& p);
+    
+    // Tour obtained by swapping the segments (positions[0], positions[1]] and (positions[1], positions[2]]
+    path apply_3opt(const path& p, const std::vector<int>& positions) const;
+
 public:
-    kopt3_solver(tsp_graph& g) : g{g} {}
-    tabu_solver::tabu_and_non_tabu_solutions solve(const path& starting_solution, const std::vector<tabu_solver::tabu_move>& tabu_moves);
+    kopt3_solver(tsp_graph& g, int candidate_list_size = 0, int scan_threads = 1, const std::string& scan_policy = "full", int scan_sample_size = 0, unsigned int seed = 0);
+    ~kopt3_solver();
+    kopt3_solver(const kopt3_solver&) = delete;
+    kopt3_solver& operator=(const kopt3_solver&) = delete;
+    tabu_solver::tabu_and_non_tabu_solutions solve(const path& starting_solution, const tabu_list& tabu);
+    long last_scan_size() const { return scan_size; }
 };
 
 #endif
\ No newline at end of file
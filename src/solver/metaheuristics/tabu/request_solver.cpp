@@ -0,0 +1,402 @@
+#include <solver/metaheuristics/tabu/request_solver.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+
+int request_solver::capacity(int from, int to) const {
+    return std::min({g.g[graph_bundle].capacity, g.draught[from], g.draught[to]});
+}
+
+// Loads of the arcs between two taken out nodes drop by the demand of their request. The
+// arcs closing the gaps cost 0 if they were removed during preprocessing, as in path::without_requests()
+int request_solver::take_out(const path& p, const std::vector<int>& position, int i, int j) {
+    auto n = g.g[graph_bundle].n;
+    
+    nodes.clear();
+    load.clear();
+    gap_of_j.clear();
+    
+    auto after_j = false;
+    
+    for(auto l = 0; l < (int)p.path_v.size(); l++) {
+        auto node = p.path_v[l];
+        
+        if(j > 0 && (node == j || node == n + j)) {
+            after_j = true;
+            continue;
+        }
+        
+        if(node == i || node == n + i) {
+            continue;
+        }
+        
+        if(!nodes.empty()) {
+            gap_of_j.push_back(after_j);
+        }
+        
+        after_j = false;
+        
+        auto node_load = p.load_v[l];
+        
+        for(auto r : {i, j}) {
+            if(r > 0 && l > position[r] && l < position[n + r]) {
+                node_load -= g.demand[r];
+            }
+        }
+        
+        nodes.push_back(node);
+        load.push_back(node_load);
+    }
+    
+    auto cost = 0;
+    
+    for(auto l = 0u; l < nodes.size() - 1; l++) {
+        cost += std::max(g.cost[nodes[l]][nodes[l + 1]], 0);
+    }
+    
+    return cost;
+}
+
+// Arcs of the tour which are removed or overloaded must be broken by the insertion. The origin
+// goes after position x and the destination after position y >= x; for x < y the arcs between
+// them take the demand of r, so y can't go past the first arc after x without enough slack.
+// Both bounds of y grow with x, so the cheapest destination for each x comes from a sliding
+// window minimum, and the whole scan takes O(n).
+request_solver::insertion request_solver::cheapest_insertion(const std::vector<int>& tour_nodes, const std::vector<int>& tour_load, int r, bool leave_gaps_of_j) {
+    auto n = g.g[graph_bundle].n;
+    auto m = (int)tour_nodes.size();
+    auto q = g.demand[r];
+    
+    auto exists = [this] (int from, int to) { return g.cost[from][to] >= 0; };
+    auto c0 = [this] (int from, int to) { return std::max(g.cost[from][to], 0); };
+    
+    slack.resize(m);
+    next_bad.resize(m);
+    dest_cost.resize(m);
+    
+    auto first_invalid = no_insertion;
+    auto last_invalid = -1;
+    
+    for(auto l = 0; l < m - 1; l++) {
+        slack[l] = (exists(tour_nodes[l], tour_nodes[l + 1]) ? capacity(tour_nodes[l], tour_nodes[l + 1]) - tour_load[l] : -1);
+        
+        if(slack[l] < 0 && leave_gaps_of_j && gap_of_j[l]) {
+            slack[l] = std::numeric_limits<int>::max();
+        } else if(slack[l] < 0) {
+            first_invalid = std::min(first_invalid, l);
+            last_invalid = l;
+        }
+    }
+    
+    // next_bad[l] = first arc from l onwards which can't take the demand of r
+    next_bad[m - 1] = m - 2;
+    
+    for(auto l = m - 2; l >= 0; l--) {
+        next_bad[l] = (slack[l] < q ? l : next_bad[l + 1]);
+        
+        auto valid_dest = (
+            exists(tour_nodes[l], n + r) && exists(n + r, tour_nodes[l + 1]) &&
+            tour_load[l] + q <= capacity(tour_nodes[l], n + r) && tour_load[l] <= capacity(n + r, tour_nodes[l + 1])
+        );
+        
+        dest_cost[l] = (valid_dest ? g.cost[tour_nodes[l]][n + r] + g.cost[n + r][tour_nodes[l + 1]] - c0(tour_nodes[l], tour_nodes[l + 1]) : no_insertion);
+    }
+    
+    auto best = insertion(no_insertion, 0, 0);
+    auto window = std::deque<int>();
+    auto next_y = 1;
+    
+    for(auto x = 0; x < m - 1 && x <= first_invalid; x++) {
+        if(!exists(tour_nodes[x], r) || tour_load[x] > capacity(tour_nodes[x], r)) {
+            continue;
+        }
+        
+        auto origin_cost = g.cost[tour_nodes[x]][r] - c0(tour_nodes[x], tour_nodes[x + 1]);
+        
+        // Origin and destination next to each other
+        if( (first_invalid == no_insertion || (first_invalid == x && last_invalid == x)) &&
+            exists(r, n + r) && exists(n + r, tour_nodes[x + 1]) &&
+            tour_load[x] + q <= capacity(r, n + r) && tour_load[x] <= capacity(n + r, tour_nodes[x + 1])
+        ) {
+            auto cost = origin_cost + g.cost[r][n + r] + g.cost[n + r][tour_nodes[x + 1]];
+            
+            if(cost < best.cost) {
+                best = insertion(cost, x, x);
+            }
+        }
+        
+        if(x + 1 > m - 2 || !exists(r, tour_nodes[x + 1]) || tour_load[x] + q > capacity(r, tour_nodes[x + 1])) {
+            continue;
+        }
+        
+        auto lowest_y = std::max(x + 1, last_invalid);
+        auto highest_y = next_bad[x + 1];
+        
+        for(; next_y <= highest_y; next_y++) {
+            if(dest_cost[next_y] == no_insertion) {
+                continue;
+            }
+            
+            while(!window.empty() && dest_cost[window.back()] >= dest_cost[next_y]) {
+                window.pop_back();
+            }
+            
+            window.push_back(next_y);
+        }
+        
+        while(!window.empty() && window.front() < lowest_y) {
+            window.pop_front();
+        }
+        
+        if(!window.empty()) {
+            auto y = window.front();
+            auto cost = origin_cost + g.cost[r][tour_nodes[x + 1]] + dest_cost[y];
+            
+            if(cost < best.cost) {
+                best = insertion(cost, x, y);
+            }
+        }
+    }
+    
+    return best;
+}
+
+void request_solver::insert(const insertion& ins, int r) {
+    auto n = g.g[graph_bundle].n;
+    auto q = g.demand[r];
+    
+    inserted_nodes.clear();
+    inserted_load.clear();
+    
+    for(auto l = 0; l < (int)nodes.size(); l++) {
+        inserted_nodes.push_back(nodes[l]);
+        inserted_load.push_back(load[l] + (l > ins.x && l <= ins.y ? q : 0));
+        
+        if(l == ins.x) {
+            inserted_nodes.push_back(r);
+            inserted_load.push_back(load[l] + q);
+        }
+        
+        if(l == ins.y) {
+            inserted_nodes.push_back(n + r);
+            inserted_load.push_back(load[l]);
+        }
+    }
+}
+
+path request_solver::relocate(const path& p) {
+    auto n = g.g[graph_bundle].n;
+    auto position = std::vector<int>(2 * n + 2, 0);
+    
+    for(auto l = 0; l < (int)p.path_v.size(); l++) {
+        position[p.path_v[l]] = l;
+    }
+    
+    auto best_cost = p.total_cost;
+    auto best_r = 0;
+    
+    for(auto r = 1; r <= n; r++) {
+        auto cost = take_out(p, position, r, 0);
+        auto ins = cheapest_insertion(nodes, load, r);
+        
+        if(ins.cost != no_insertion && cost + ins.cost < best_cost) {
+            best_cost = cost + ins.cost;
+            best_r = r;
+        }
+    }
+    
+    if(best_r == 0) {
+        return path();
+    }
+    
+    take_out(p, position, best_r, 0);
+    insert(cheapest_insertion(nodes, load, best_r), best_r);
+    
+    return path(g, inserted_nodes);
+}
+
+// The insertion of the first request must break the removed or overloaded arcs, except those
+// closing the places of the second request: these are left to its insertion, which is made in
+// the tour with the first request and must break every removed or overloaded arc left there
+path request_solver::relocate_pair(const path& p) {
+    auto n = g.g[graph_bundle].n;
+    auto position = std::vector<int>(2 * n + 2, 0);
+    
+    for(auto l = 0; l < (int)p.path_v.size(); l++) {
+        position[p.path_v[l]] = l;
+    }
+    
+    auto best_cost = p.total_cost;
+    auto best_i = 0;
+    auto best_j = 0;
+    
+    for(auto i = 1; i <= n; i++) {
+        for(auto j = i + 1; j <= n; j++) {
+            auto cost = take_out(p, position, i, j);
+            auto ins_i = cheapest_insertion(nodes, load, i, true);
+            
+            if(ins_i.cost == no_insertion) {
+                continue;
+            }
+            
+            insert(ins_i, i);
+            
+            auto ins_j = cheapest_insertion(inserted_nodes, inserted_load, j);
+            
+            if(ins_j.cost != no_insertion && cost + ins_i.cost + ins_j.cost < best_cost) {
+                best_cost = cost + ins_i.cost + ins_j.cost;
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+    
+    if(best_i == 0) {
+        return path();
+    }
+    
+    take_out(p, position, best_i, best_j);
+    insert(cheapest_insertion(nodes, load, best_i, true), best_i);
+    nodes.swap(inserted_nodes);
+    load.swap(inserted_load);
+    insert(cheapest_insertion(nodes, load, best_j), best_j);
+    
+    return path(g, inserted_nodes);
+}
+
+// Exchanging requests i and j changes the arcs around their four positions, and the load of
+// the arcs carrying one of them but not the other by +/- (demand of j - demand of i). The
+// changed arcs are checked one by one; the other arcs whose load grows, by a range minimum
+// query on their slacks (sparse table).
+path request_solver::swap(const path& p) const {
+    auto n = g.g[graph_bundle].n;
+    const auto& v = p.path_v;
+    const auto& load = p.load_v;
+    auto size = (int)v.size();
+    
+    auto position = std::vector<int>(2 * n + 2, 0);
+    
+    for(auto l = 0; l < size; l++) {
+        position[v[l]] = l;
+    }
+    
+    // min_slack[e][l] = minimum slack of the arcs leaving positions l to l + 2^e - 1
+    auto min_slack = std::vector<std::vector<int>>(1, std::vector<int>(size - 1));
+    
+    for(auto l = 0; l < size - 1; l++) {
+        min_slack[0][l] = capacity(v[l], v[l + 1]) - load[l];
+    }
+    
+    for(auto e = 1; (1 << e) <= size - 1; e++) {
+        min_slack.push_back(std::vector<int>(size - (1 << e)));
+        
+        for(auto l = 0; l + (1 << e) <= size - 1; l++) {
+            min_slack[e][l] = std::min(min_slack[e - 1][l], min_slack[e - 1][l + (1 << (e - 1))]);
+        }
+    }
+    
+    // Minimum slack of the arcs leaving positions from to to - 1
+    auto range_min = [&min_slack] (int from, int to) {
+        auto e = 0;
+        
+        while((2 << e) <= to - from) {
+            e++;
+        }
+        
+        return std::min(min_slack[e][from], min_slack[e][to - (1 << e)]);
+    };
+    
+    auto best_cost = p.total_cost;
+    auto best_i = 0;
+    auto best_j = 0;
+    
+    for(auto i = 1; i <= n; i++) {
+        for(auto j = i + 1; j <= n; j++) {
+            int positions[] = {position[i], position[n + i], position[j], position[n + j]};
+            int new_node[] = {j, n + j, i, n + i};
+            
+            auto node_at = [&] (int l) {
+                for(auto k = 0; k < 4; k++) {
+                    if(positions[k] == l) { return new_node[k]; }
+                }
+                
+                return v[l];
+            };
+            
+            auto extra = g.demand[j] - g.demand[i];
+            auto extra_load = [&] (int l) {
+                return extra * ((l >= positions[0] && l < positions[1]) - (l >= positions[2] && l < positions[3]));
+            };
+            
+            // Arcs leaving the positions before and at the four moved nodes
+            int changed[8];
+            auto n_changed = 0;
+            
+            for(auto k = 0; k < 4; k++) {
+                changed[n_changed++] = positions[k] - 1;
+                changed[n_changed++] = positions[k];
+            }
+            
+            std::sort(changed, changed + n_changed);
+            n_changed = std::unique(changed, changed + n_changed) - changed;
+            
+            auto cost = p.total_cost;
+            auto feasible = true;
+            
+            for(auto k = 0; k < n_changed && feasible; k++) {
+                auto l = changed[k];
+                auto from = node_at(l);
+                auto to = node_at(l + 1);
+                
+                feasible = (g.cost[from][to] >= 0 && load[l] + extra_load(l) <= capacity(from, to));
+                cost += g.cost[from][to] - g.cost[v[l]][v[l + 1]];
+            }
+            
+            if(!feasible || cost >= best_cost) {
+                continue;
+            }
+            
+            // Unchanged arcs whose load grows: those carrying the request with the larger demand only
+            auto outer_from = (extra > 0 ? positions[0] : positions[2]);
+            auto outer_to = (extra > 0 ? positions[1] : positions[3]);
+            auto inner_from = (extra > 0 ? positions[2] : positions[0]);
+            auto inner_to = (extra > 0 ? positions[3] : positions[1]);
+            int ranges[][2] = {{outer_from, std::min(outer_to, inner_from)}, {std::max(outer_from, inner_to), outer_to}};
+            
+            for(auto range = 0; range < 2 && feasible && extra != 0; range++) {
+                auto from = ranges[range][0];
+                
+                for(auto k = 0; k <= n_changed && feasible; k++) {
+                    auto to = (k < n_changed ? std::min(changed[k], ranges[range][1]) : ranges[range][1]);
+                    
+                    if(from < to) {
+                        feasible = (range_min(from, to) >= std::abs(extra));
+                    }
+                    
+                    if(k < n_changed) {
+                        from = std::max(from, changed[k] + 1);
+                    }
+                }
+            }
+            
+            if(feasible) {
+                best_cost = cost;
+                best_i = i;
+                best_j = j;
+            }
+        }
+    }
+    
+    if(best_i == 0) {
+        return path();
+    }
+    
+    auto new_nodes = v;
+    
+    std::swap(new_nodes[position[best_i]], new_nodes[position[best_j]]);
+    std::swap(new_nodes[position[n + best_i]], new_nodes[position[n + best_j]]);
+    
+    return path(g, new_nodes);
+}
\ No newline at end of file
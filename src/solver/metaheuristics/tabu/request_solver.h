@@ -0,0 +1,67 @@
+#ifndef REQUEST_SOLVER_H
+#define REQUEST_SOLVER_H
+
+#include <network/tsp_graph.h>
+#include <network/path.h>
+
+#include <limits>
+#include <vector>
+
+// Neighbourhoods moving whole requests, which the 3-opt segment swaps can't do:
+// - relocate: take out the origin and the destination of a request, and insert them back
+//   in the cheapest feasible positions;
+// - swap: exchange the positions of two requests, origin with origin and destination with
+//   destination;
+// - relocate_pair: take out two requests, and insert back the first and then the second.
+// Moves are evaluated in delta form, from the arcs they remove and add and from the slacks
+// of the arcs whose load changes, as in kopt3_solver. The cheapest insertion of a request
+// takes O(n), so relocate takes O(n^2), swap O(n^2 log n) and relocate_pair O(n^3) over all
+// the requests or pairs. Only the chosen move is built.
+// All of them return the best improving tour, or an empty path if there is none.
+class request_solver {
+    const tsp_graph& g;
+    
+    // Insertion of a request in a tour: change in cost, and positions after which the origin and the destination go
+    struct insertion {
+        int cost;
+        int x;
+        int y;
+        
+        insertion(int cost, int x, int y) : cost{cost}, x{x}, y{y} {}
+    };
+    
+    // A tour with some requests taken out, the same tour with one request inserted back, and
+    // the slacks and the destination costs used by cheapest_insertion()
+    std::vector<int> nodes;
+    std::vector<int> load;
+    std::vector<bool> gap_of_j;
+    std::vector<int> inserted_nodes;
+    std::vector<int> inserted_load;
+    std::vector<int> slack;
+    std::vector<int> next_bad;
+    std::vector<int> dest_cost;
+    
+    int capacity(int from, int to) const;
+    
+    // Tour p without requests i and j (0 for none) in nodes and load, and its cost. gap_of_j marks
+    // the arcs of nodes which close the place of a node of j
+    int take_out(const path& p, const std::vector<int>& position, int i, int j);
+    
+    // Cheapest feasible insertion of request r in the tour tour_nodes, whose arcs leaving each position
+    // carry tour_load. Its cost is no_insertion if there is none. With leave_gaps_of_j, tour_nodes must
+    // be nodes, and the removed or overloaded arcs marked in gap_of_j are left for the insertion of j
+    insertion cheapest_insertion(const std::vector<int>& tour_nodes, const std::vector<int>& tour_load, int r, bool leave_gaps_of_j = false);
+    
+    // Insertion of request r in nodes and load, written to inserted_nodes and inserted_load
+    void insert(const insertion& ins, int r);
+    
+    static constexpr int no_insertion = std::numeric_limits<int>::max();
+
+public:
+    request_solver(const tsp_graph& g) : g{g} {}
+    path relocate(const path& p);
+    path swap(const path& p) const;
+    path relocate_pair(const path& p);
+};
+
+#endif
\ No newline at end of file
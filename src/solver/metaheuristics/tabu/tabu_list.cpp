@@ -0,0 +1,22 @@
+#include <solver/metaheuristics/tabu/tabu_list.h>
+
+tabu_list::tabu_list(int number_of_nodes, int tabu_list_size) : tabu_list_size{tabu_list_size}, insertions{0}, released_up_to{0} {
+    stamp = std::vector<std::vector<int>>(number_of_nodes, std::vector<int>(number_of_nodes, 0));
+}
+
+int tabu_list::remaining_tenure(int i, int j) const {
+    return (is_tabu(i, j) ? stamp_of(i, j) - insertions + tabu_list_size : 0);
+}
+
+void tabu_list::insert(const tabu_solver::tabu_move& move) {
+    if(is_tabu(move.vertices.first, move.vertices.second)) {
+        return;
+    }
+    
+    stamp_of(move.vertices.first, move.vertices.second) = ++insertions;
+}
+
+void tabu_list::resize(int new_size) {
+    released_up_to = oldest_tabu_stamp() - 1;
+    tabu_list_size = new_size;
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef TABU_LIST_H
+#define TABU_LIST_H
+
+#include <solver/metaheuristics/tabu/tabu_solver.h>
+
+#include <algorithm>
+#include <vector>
+
+// FIFO list of the last tabu_list_size distinct (undirected) edges erased by the search.
+// Each edge stores the number of insertions made when it was last inserted, so an edge is
+// tabu if it is among the last tabu_list_size insertions: lookups and insertions take O(1).
+class tabu_list {
+    int                             tabu_list_size;
+    int                             insertions;
+    std::vector<std::vector<int>>   stamp;
+    
+    // Edges released by a shrinking of the list stay released when it grows back
+    int                             released_up_to;
+    
+    int& stamp_of(int i, int j) { return (i < j ? stamp[i][j] : stamp[j][i]); }
+    int stamp_of(int i, int j) const { return (i < j ? stamp[i][j] : stamp[j][i]); }
+    
+    // Edges never inserted have stamp 0, so they aren't tabu even before the list is full
+    int oldest_tabu_stamp() const { return std::max({0, insertions - tabu_list_size, released_up_to}) + 1; }
+
+public:
+    tabu_list(int number_of_nodes, int tabu_list_size);
+    
+    bool is_tabu(int i, int j) const { return stamp_of(i, j) >= oldest_tabu_stamp(); }
+    
+    // Number of further insertions after which edge {i,j} stops being tabu (0 if it isn't)
+    int remaining_tenure(int i, int j) const;
+    
+    // Does nothing if the edge is already tabu, otherwise makes it tabu and, if the list
+    // was full, releases the oldest edge
+    void insert(const tabu_solver::tabu_move& move);
+    
+    int size() const { return tabu_list_size; }
+    
+    // Shrinking releases the oldest edges at once, growing keeps the next insertions longer
+    void resize(int new_size);
+};
+
+#endif
\ No newline at end of file
@@ -1,78 +1,34 @@
+#include <heuristics/k_exchange_solver.h>
+#include <solver/metaheuristics/path_relinker.h>
+#include <solver/metaheuristics/progress_sink.h>
+#include <solver/metaheuristics/visited_tours.h>
 #include <solver/metaheuristics/tabu/kopt3_solver.h>
+#include <solver/metaheuristics/tabu/request_solver.h>
+#include <solver/metaheuristics/tabu/tabu_list.h>
 #include <solver/metaheuristics/tabu/tabu_solver.h>
 
+#include <atomic>
 #include <chrono>
+#include <exception>
 #include <fstream>
-#include <mutex>
+#include <sstream>
 #include <thread>
 
-tabu_solver::tabu_solver(tsp_graph& g, const program_params& params, program_data& data, std::vector<path> initial_solutions) : g{g}, params{params}, data{data}, initial_solutions{initial_solutions} {
-    auto max_parallel_searches = std::min(params.ts.max_parallel_searches, (int)initial_solutions.size());
-    
-    std::partial_sort(
-        initial_solutions.begin(),
-        initial_solutions.begin() + max_parallel_searches,
-        initial_solutions.end(),
-        [] (const auto& lhs, const auto& rhs) {
-            return lhs.total_cost < rhs.total_cost;
-        }
-    );
-    
-    auto last = std::unique(initial_solutions.begin(), initial_solutions.end());
-    auto my_desired_last = initial_solutions.begin() + max_parallel_searches;
-    last = (std::distance(last, my_desired_last) >= 0) ? last : my_desired_last;
-    
-    sliced_initial_solutions = std::vector<path>(initial_solutions.begin(), last);
-    
+tabu_solver::tabu_solver(tsp_graph& g, const program_params& params, program_data& data, elite_pool& solution_pool) : g{g}, params{params}, data{data}, solution_pool{solution_pool}, initial_solutions{solution_pool.get_solutions()}, cancelled{false}, target_reached{false}, deadline{std::chrono::high_resolution_clock::time_point::max()}, local_optima(params.ts.visited_tours_memory) {
     tabu_list_size = params.ts.tabu_list_size;
 }
 
 void tabu_solver::solve_parameter_tuning() {
-    for(auto lsize : params.ts_tuning.tabu_list_size) {
-        tabu_list_size = lsize;
-        solve_sequential();
-    }
-}
-
-std::vector<path> tabu_solver::solve_sequential() {
-    std::cout << "Metaheuristic starts:    \t";
-    for(const auto& s : initial_solutions) {
-        std::cout << s.total_cost << "\t";
+    // The reactive tenure adapts the list size within each search: there is nothing to sweep
+    if(params.ts.reactive_tenure) {
+        solve();
+        return;
     }
-    std::cout << std::endl;
-    
-    auto solutions = std::vector<path>();
     
-    using namespace std::chrono;
-    
-    auto t_start = high_resolution_clock::now();
-    
-    for(const auto& init_sol : initial_solutions) {
-        solutions.push_back(tabu_search(init_sol));
-    }
-    
-    auto t_end = high_resolution_clock::now();
-    auto time_span = duration_cast<duration<double>>(t_end - t_start);
-    data.time_spent_by_tabu_search = time_span.count();
-    
-    std::cout << "Metaheuristic solutions: \t";
-    for(const auto& path : solutions) {
-        std::cout << path.total_cost << "\t";
-    }
-    std::cout << std::endl;
-    std::cout << "Solutions obtained in " << data.time_spent_by_tabu_search << " seconds." << std::endl;
-    
-    print_results(solutions);
-    
-    if(solutions.size() > 0u) {
-        auto best_solution = std::min_element(solutions.begin(), solutions.end(), [] (const auto& p1, const auto& p2) { return p1.total_cost < p2.total_cost; });
-        assert(best_solution != solutions.end());
-        data.best_tabu_solution = (*best_solution).total_cost;
-    } else {
-        data.best_tabu_solution = std::numeric_limits<double>::max();
+    for(auto lsize : params.ts_tuning.tabu_list_size) {
+        tabu_list_size = lsize;
+        solve();
     }
-    
-    return solutions;
 }
 
 void tabu_solver::print_results(const std::vector<path>& solutions) const {
@@ -90,47 +46,124 @@ void tabu_solver::print_results(const std::vector<path>& solutions) const {
 }
 
 std::vector<path> tabu_solver::solve() {
+    using namespace std::chrono;
+    
     std::cout << "Metaheuristic starts:    \t";
-    for(const auto& s : sliced_initial_solutions) {
-        std::cout << s.total_cost << "\t";
+    for(const auto& s : initial_solutions) {
+        std::cout << s->total_cost << "\t";
     }
     std::cout << std::endl;
     
-    auto solutions = std::vector<path>();
-    auto threads = std::vector<std::thread>();
-    std::mutex mtx;
+    auto n_searches = std::max(1, std::min(params.ts.max_parallel_searches, (int)initial_solutions.size()));
+    auto results = std::vector<path>(initial_solutions.size());
+    auto search_times = std::vector<double>(initial_solutions.size(), -1.0); // Negative for tours not searched
+    auto errors = std::vector<std::exception_ptr>(n_searches);
+    std::atomic<int> next_solution(0);
+    auto searches = std::vector<std::thread>();
+    elite_pool elite(params.ts.elite_pool_size);
+    
+    auto progress_file_name = std::stringstream();
+    
+    // The sink truncates its file: the start time of the run, in milliseconds, keeps runs with the same list size apart
+    if(params.ts.track_progress) {
+        auto run_stamp = duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+        progress_file_name << params.ts.progress_results_dir << g.g[graph_bundle].instance_name << "_" << tabu_list_size << "_" << run_stamp << ".dat";
+    }
+    
+    progress_sink progress(progress_file_name.str());
     
-    for(const auto& init_sol : sliced_initial_solutions) {
-        threads.push_back(std::thread(
-            [this, init_sol, &solutions, &mtx] () {
-                auto solution = tabu_search(init_sol);
+    auto t_start = high_resolution_clock::now();
+    
+    target_reached = false;
+    deadline = (params.ts.time_limit > 0 ? t_start + duration_cast<high_resolution_clock::duration>(duration<double>(params.ts.time_limit)) : high_resolution_clock::time_point::max());
+    
+    // The tabu search only reads the graph, so the workers share it. Each one takes
+    // the next starting tour until there are none left or the searches must stop.
+    auto run_searches = [this, &results, &search_times, &errors, &next_solution, &elite, &progress] (int s) {
+        try {
+            for(auto sol_n = next_solution++; sol_n < (int)initial_solutions.size() && !must_stop(); sol_n = next_solution++) {
+                auto t_search_start = high_resolution_clock::now();
                 
-                std::lock_guard<std::mutex> guard(mtx);
-                solutions.push_back(solution);
+                results[sol_n] = tabu_search(*initial_solutions[sol_n], elite, progress, sol_n);
+                
+                auto t_search_end = high_resolution_clock::now();
+                search_times[sol_n] = duration_cast<duration<double>>(t_search_end - t_search_start).count();
             }
-        ));
+        } catch(...) {
+            errors[s] = std::current_exception();
+        }
+    };
+    
+    if(n_searches == 1) {
+        run_searches(0);
+    } else {
+        for(auto s = 0; s < n_searches; s++) {
+            searches.push_back(std::thread(run_searches, s));
+        }
+        
+        for(auto& t : searches) {
+            t.join();
+        }
     }
     
-    using namespace std::chrono;
+    for(const auto& error : errors) {
+        if(error) {
+            std::rethrow_exception(error);
+        }
+    }
     
-    auto t_start = high_resolution_clock::now();
+    // Results keep the order of the starting tours; those not searched because the searches stopped are left out
+    auto solutions = std::vector<path>();
+    
+    std::cout << "Metaheuristic solutions: \t";
+    for(auto sol_n = 0u; sol_n < initial_solutions.size(); sol_n++) {
+        if(search_times[sol_n] >= 0) {
+            std::cout << results[sol_n].total_cost << "\t";
+            solutions.push_back(std::move(results[sol_n]));
+        }
+    }
+    std::cout << std::endl;
+    
+    std::cout << "Metaheuristic times:     \t";
+    for(auto sol_n = 0u; sol_n < initial_solutions.size(); sol_n++) {
+        if(search_times[sol_n] >= 0) {
+            std::cout << search_times[sol_n] << "\t";
+        }
+    }
+    std::cout << std::endl;
+    
+    // Relinked tours come after those of the searches
+    if(params.ts.relinking_elite_size > 1 && !must_stop()) {
+        elite_pool relinking_pool(params.ts.relinking_elite_size);
+        
+        for(const auto& p : elite.get_solutions()) {
+            relinking_pool.offer(p);
+        }
+        
+        for(const auto& p : solutions) {
+            relinking_pool.offer(p);
+        }
+        
+        auto relinked = path_relinking(relinking_pool.get_solutions());
+        
+        std::cout << "Path relinking solutions:\t";
+        for(const auto& p : relinked) {
+            std::cout << p.total_cost << "\t";
+        }
+        std::cout << std::endl;
+        
+        solutions.insert(solutions.end(), relinked.begin(), relinked.end());
+    }
     
-    for(auto& t : threads) {
-        t.join();
+    for(const auto& p : solutions) {
+        solution_pool.offer(p);
     }
     
     auto t_end = high_resolution_clock::now();
     auto time_span = duration_cast<duration<double>>(t_end - t_start);
     data.time_spent_by_tabu_search = time_span.count();
-
-    std::cout << "Metaheuristic solutions: \t";
-    for(const auto& path : solutions) {
-        std::cout << path.total_cost << "\t";
-    }
-    std::cout << std::endl;
+    
     std::cout << "Solutions obtained in " << data.time_spent_by_tabu_search << " seconds." << std::endl;
-
-    print_results(solutions);
     
     if(solutions.size() > 0u) {
         auto best_solution = std::min_element(solutions.begin(), solutions.end(), [] (const auto& p1, const auto& p2) { return p1.total_cost < p2.total_cost; });
@@ -140,85 +173,326 @@ std::vector<path> tabu_solver::solve() {
         data.best_tabu_solution = std::numeric_limits<double>::max();
     }
     
+    print_results(solutions);
+    
     return solutions;
 }
 
-path tabu_solver::tabu_search(path init_sol) {
+// With an elite pool, searches are islands: every migration_interval iterations a search publishes
+// its best tour to the pool, and it restarts from a perturbed elite tour when it stagnates, or
+// when it has not improved for migration_interval iterations and its best is worse than the pool's.
+// The 3-opt moves can't reorder more than a few nodes at once: the best reordering within a window,
+// which takes a few milliseconds, is looked for on each restart tour and on the final best tour.
+path tabu_solver::tabu_search(path init_sol, elite_pool& elite, progress_sink& progress, int search_id) {
+    auto kexchsolv = k_exchange_solver(g);
+    
+    auto polish = [this, &kexchsolv] (path& p) {
+        if(params.ts.k_exchange_window > 1) {
+            auto polished_solution = kexchsolv.solve(p, params.ts.k_exchange_window);
+            
+            if(polished_solution.total_cost < p.total_cost - eps) {
+                p = std::move(polished_solution);
+            }
+        }
+    };
+    
+    auto initial_tenure = (params.ts.reactive_tenure ? std::max(params.ts.min_tabu_list_size, std::min(params.ts.max_tabu_list_size, tabu_list_size)) : tabu_list_size);
     auto current_solution = init_sol;
-    auto best_solution = init_sol;
-    auto tabu_list = std::vector<tabu_move>();
+    auto best_solution = std::move(init_sol);
+    auto tabu = tabu_list(2 * g.g[graph_bundle].n + 2, initial_tenure);
+    auto visited = visited_tours(params.ts.visited_tours_memory);
+    auto last_tenure_change = 0;
     auto consecutive_not_improved = 0;
     auto iteration = 0;
-    auto progress_report = std::vector<std::pair<int, int>>();
-    auto kopt3solv = kopt3_solver(g);
+    kopt3_solver kopt3solv(g, params.ts.candidate_list_size, params.ts.scan_threads, params.ts.scan_policy, params.ts.scan_sample_size, search_id);
+    auto restarts = 0;
+    auto gen = std::mt19937(search_id);
+    auto descent_pending = false;
     
-    if(params.ts.track_progress) {
-        progress_report.push_back(std::make_pair(0, init_sol.total_cost));
-    }
+    progress.record(search_id, 0, current_solution.total_cost, best_solution.total_cost, 0);
         
-    while(iteration < params.ts.max_iter && consecutive_not_improved < params.ts.max_iter_without_improving) {        
-        auto tabu_and_non_tabu = kopt3solv.solve(current_solution, tabu_list);
+    while(iteration < params.ts.max_iter && consecutive_not_improved < params.ts.max_iter_without_improving && !must_stop()) {        
+        auto tabu_and_non_tabu = kopt3solv.solve(current_solution, tabu);
+        auto scan_size = kopt3solv.last_scan_size();
 
-        auto overall_best_solution = tabu_and_non_tabu.overall_best;
-        auto best_without_tabu_solution = tabu_and_non_tabu.best_without_tabu;
+        auto& overall_best_solution = tabu_and_non_tabu.overall_best;
+        auto& best_without_tabu_solution = tabu_and_non_tabu.best_without_tabu;
+
+        auto descended_solution = path();
+        
+        // A new best tour is a 3-opt local optimum once no move improves it: the request moves may still do
+        if(params.ts.request_moves && descent_pending && !overall_best_solution.empty() && overall_best_solution.p.total_cost >= current_solution.total_cost) {
+            descent_pending = false;
+            descended_solution = variable_neighbourhood_descent(current_solution, kopt3solv);
+        }
 
         if(overall_best_solution.empty()) {
             assert(best_without_tabu_solution.empty() && "Could not produce a general move but I have an halal move?!");
             
             std::cerr << "tabu_solver.cpp::tabu_search() \t Tabu error: 3-opt solver could not produce any valid move!" << std::endl;
             return path();
+        } else if(!descended_solution.path_v.empty() && descended_solution.total_cost < best_solution.total_cost - eps) {
+            consecutive_not_improved = 0;
+            best_solution = descended_solution;
+            current_solution = std::move(descended_solution);
+            progress.record(search_id, iteration, current_solution.total_cost, best_solution.total_cost, scan_size);
         } else {
             if(overall_best_solution.p.total_cost < best_solution.total_cost - eps) {
                 consecutive_not_improved = 0;
-                update_tabu_list(tabu_list, overall_best_solution);
-                current_solution = overall_best_solution.p;
+                descent_pending = true;
+                tabu.insert(overall_best_solution.shortest_erased_edge);
                 best_solution = overall_best_solution.p;
-                                
-                if(params.ts.track_progress) {
-                    progress_report.push_back(std::make_pair(iteration, best_solution.total_cost));
-                }
+                current_solution = std::move(overall_best_solution.p);
+                progress.record(search_id, iteration, current_solution.total_cost, best_solution.total_cost, scan_size);
             } else {
                 consecutive_not_improved++;
                 if(best_without_tabu_solution.empty()) {
-                    update_tabu_list(tabu_list, overall_best_solution);
-                    current_solution = overall_best_solution.p;
+                    tabu.insert(overall_best_solution.shortest_erased_edge);
+                    current_solution = std::move(overall_best_solution.p);
                 } else {
-                    update_tabu_list(tabu_list, best_without_tabu_solution);
-                    current_solution = best_without_tabu_solution.p;
+                    tabu.insert(best_without_tabu_solution.shortest_erased_edge);
+                    current_solution = std::move(best_without_tabu_solution.p);
                 }
             }
         }
 
+        // Reactive tenure (Battiti and Tecchiolli, 1994): a tour visited again means the search is cycling,
+        // so the list grows; a long stretch without repetitions means it constrains the search too much
+        if(params.ts.reactive_tenure) {
+            if(!visited.insert(current_solution)) {
+                tabu.resize(std::min(params.ts.max_tabu_list_size, std::max(tabu.size() + 1, (int)(tabu.size() * params.ts.tenure_increase))));
+                last_tenure_change = iteration;
+            } else if(iteration - last_tenure_change >= params.ts.tenure_decrease_interval) {
+                tabu.resize(std::max(params.ts.min_tabu_list_size, std::min(tabu.size() - 1, (int)(tabu.size() * params.ts.tenure_decrease))));
+                last_tenure_change = iteration;
+            }
+        }
+
         iteration++;
+        
+        if(params.ts.progress_interval > 0 && iteration % params.ts.progress_interval == 0) {
+            progress.record(search_id, iteration, current_solution.total_cost, best_solution.total_cost, scan_size);
+        }
+        
+        if(elite.enabled()) {
+            auto migration = (params.ts.migration_interval > 0 && iteration % params.ts.migration_interval == 0);
+            
+            if(migration) {
+                elite.offer(best_solution);
+            }
+            
+            auto stagnant = (consecutive_not_improved >= params.ts.max_iter_without_improving);
+            auto behind = (migration && consecutive_not_improved >= params.ts.migration_interval && best_solution.total_cost > elite.best_cost());
+            
+            if((stagnant || behind) && restarts < params.ts.max_restarts) {
+                elite.offer(best_solution);
+                
+                auto elite_solution = elite.pick(gen);
+                auto restart_solution = (elite_solution ? perturb(*elite_solution, gen) : path());
+                
+                if(!restart_solution.path_v.empty()) {
+                    polish(restart_solution);
+                    
+                    current_solution = std::move(restart_solution);
+                    consecutive_not_improved = 0;
+                    restarts++;
+                    
+                    // The tabu arcs, the visited tours and the tenure come from the region left behind
+                    tabu = tabu_list(2 * g.g[graph_bundle].n + 2, initial_tenure);
+                    visited = visited_tours(params.ts.visited_tours_memory);
+                    last_tenure_change = iteration;
+                    descent_pending = false;
+                    
+                    if(current_solution.total_cost < best_solution.total_cost - eps) {
+                        best_solution = current_solution;
+                    }
+                }
+            }
+        }
+        
+        // A tour good enough for the caller stops every search
+        if(params.ts.target_cost > 0 && best_solution.total_cost <= params.ts.target_cost) {
+            target_reached = true;
+        }
     }
     
-    if(params.ts.track_progress) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(1, 9999);
+    polish(best_solution);
+    
+    progress.record(search_id, iteration, current_solution.total_cost, best_solution.total_cost, kopt3solv.last_scan_size());
+    
+    return best_solution;
+}
+
+// Swaps random pairs of consecutive segments, as the 3-opt moves do, keeping the tour feasible
+path tabu_solver::perturb(path p, std::mt19937& gen) const {
+    auto n = g.g[graph_bundle].n;
+    auto Q = g.g[graph_bundle].capacity;
+    auto size = (int)p.path_v.size();
+    
+    if(size < 5) {
+        return p;
+    }
+    
+    auto dis = std::uniform_int_distribution<int>(0, size - 2);
+    auto moves = 0;
+    
+    for(auto attempt = 0; attempt < max_perturbation_attempts && moves < perturbation_moves; attempt++) {
+        int positions[] = {dis(gen), dis(gen), dis(gen)};
         
-        std::stringstream file_name_ss;
-        file_name_ss << params.ts.progress_results_dir << g.g[graph_bundle].instance_name << "_" << dis(gen) << ".dat";
+        std::sort(positions, positions + 3);
+        
+        if(positions[0] == positions[1] || positions[1] == positions[2]) {
+            continue;
+        }
         
-        std::ofstream progress_file;
-        progress_file.open(file_name_ss.str(), std::ios::out | std::ios::app);
+        auto nodes = std::vector<int>();
         
-        for(const auto& prg : progress_report) {
-            progress_file << prg.first << "\t" << prg.second << std::endl;
+        nodes.reserve(size);
+        nodes.insert(nodes.end(), p.path_v.begin(), p.path_v.begin() + positions[0] + 1);
+        nodes.insert(nodes.end(), p.path_v.begin() + positions[1] + 1, p.path_v.begin() + positions[2] + 1);
+        nodes.insert(nodes.end(), p.path_v.begin() + positions[0] + 1, p.path_v.begin() + positions[1] + 1);
+        nodes.insert(nodes.end(), p.path_v.begin() + positions[2] + 1, p.path_v.end());
+        
+        auto feasible = true;
+        auto visited = std::vector<bool>(2 * n + 2, false);
+        auto load = 0;
+        
+        for(auto l = 0; l < size - 1 && feasible; l++) {
+            auto i = nodes[l];
+            auto j = nodes[l+1];
+            
+            visited[i] = true;
+            load += g.demand[i];
+            
+            if( g.cost[i][j] < 0 ||
+                load > std::min({Q, g.draught[i], g.draught[j]}) ||
+                (j > n && j <= 2 * n && !visited[j - n])
+            ) {
+                feasible = false;
+            }
         }
         
-        progress_file.close();
+        if(feasible) {
+            p = path(g, nodes);
+            moves++;
+        }
     }
     
-    return best_solution;
+    return p;
+}
+
+// Best improving 3-opt move, then best request relocation, best request swap and best relocation
+// of a pair of requests: after each improvement the descent goes back to the 3-opt neighbourhood
+path tabu_solver::variable_neighbourhood_descent(path p, kopt3_solver& kopt3solv) const {
+    auto rsolv = request_solver(g);
+    auto no_tabu = tabu_list(2 * g.g[graph_bundle].n + 2, 0);
+    auto neighbourhood = 0;
+    
+    auto known_local_optimum = [this] (const path& p) {
+        std::lock_guard<std::mutex> lock(local_optima_mutex);
+        return local_optima.contains(p);
+    };
+    
+    while(neighbourhood < 4) {
+        if(neighbourhood == 0 && known_local_optimum(p)) {
+            return p;
+        }
+        
+        auto q = path();
+        
+        if(neighbourhood == 0) {
+            q = std::move(kopt3solv.solve(p, no_tabu).overall_best.p);
+        } else if(neighbourhood == 1) {
+            q = rsolv.relocate(p);
+        } else if(neighbourhood == 2) {
+            q = rsolv.swap(p);
+        } else {
+            q = rsolv.relocate_pair(p);
+        }
+        
+        if(!q.path_v.empty() && q.total_cost < p.total_cost) {
+            p = std::move(q);
+            neighbourhood = 0;
+        } else {
+            neighbourhood++;
+        }
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(local_optima_mutex);
+        local_optima.insert(p);
+    }
+    
+    return p;
 }
 
-void tabu_solver::update_tabu_list(std::vector<tabu_move>& tabu_list, const tabu_solver::tabu_result& sol) {
-    if(std::find(tabu_list.begin(), tabu_list.end(), sol.shortest_erased_edge) == tabu_list.end()) {
-        tabu_list.push_back(sol.shortest_erased_edge);
+// The pairs are shared by max_parallel_searches workers as the starting tours are. The best intermediate
+// tour of each walk is rarely a local optimum, so it goes through the variable neighbourhood descent.
+std::vector<path> tabu_solver::path_relinking(const std::vector<tour_ptr>& elite_solutions) const {
+    using namespace std::chrono;
+    
+    auto pairs = std::vector<std::pair<int, int>>();
+    
+    for(auto from = 0u; from < elite_solutions.size(); from++) {
+        for(auto to = 0u; to < elite_solutions.size(); to++) {
+            if(from != to) {
+                pairs.push_back(std::make_pair(from, to));
+            }
+        }
+    }
+    
+    auto deadline = std::min(this->deadline, high_resolution_clock::now() + duration_cast<high_resolution_clock::duration>(duration<double>(params.ts.relinking_time_limit)));
+    auto n_workers = std::max(1, std::min(params.ts.max_parallel_searches, (int)pairs.size()));
+    auto results = std::vector<path>(pairs.size());
+    auto errors = std::vector<std::exception_ptr>(n_workers);
+    std::atomic<int> next_pair(0);
+    auto workers = std::vector<std::thread>();
+    
+    auto run_relinking = [this, &elite_solutions, &pairs, &deadline, &results, &errors, &next_pair] (int w) {
+        try {
+            kopt3_solver kopt3solv(g, params.ts.candidate_list_size, params.ts.scan_threads, params.ts.scan_policy, params.ts.scan_sample_size, w);
+            auto relinker = path_relinker(g);
+            auto descended = visited_tours(params.ts.visited_tours_memory);
+            
+            for(auto pair_n = next_pair++; pair_n < (int)pairs.size() && !cancelled && !target_reached && high_resolution_clock::now() < deadline; pair_n = next_pair++) {
+                const auto& from = *elite_solutions[pairs[pair_n].first];
+                const auto& to = *elite_solutions[pairs[pair_n].second];
+                auto relinked = relinker.relink(from, to, deadline);
+                
+                // Walks between different pairs often meet: descend from each tour only once
+                if(!relinked.path_v.empty() && descended.insert(relinked)) {
+                    relinked = variable_neighbourhood_descent(std::move(relinked), kopt3solv);
+                    
+                    if(relinked.total_cost < std::min(from.total_cost, to.total_cost) - eps) {
+                        results[pair_n] = std::move(relinked);
+                    }
+                }
+            }
+        } catch(...) {
+            errors[w] = std::current_exception();
+        }
+    };
+    
+    if(n_workers == 1) {
+        run_relinking(0);
+    } else {
+        for(auto w = 0; w < n_workers; w++) {
+            workers.push_back(std::thread(run_relinking, w));
+        }
+        
+        for(auto& t : workers) {
+            t.join();
+        }
     }
     
-    if((int)tabu_list.size() > tabu_list_size) {
-        tabu_list.erase(tabu_list.begin());
+    for(const auto& error : errors) {
+        if(error) {
+            std::rethrow_exception(error);
+        }
     }
+    
+    results.erase(std::remove_if(results.begin(), results.end(), [] (const auto& p) { return p.path_v.empty(); }), results.end());
+    path::remove_duplicates(results);
+    
+    return results;
 }
\ No newline at end of file
@@ -3,18 +3,34 @@
 
 #include <network/tsp_graph.h>
 #include <network/path.h>
+#include <program/elite_pool.h>
 #include <program/program_data.h>
 #include <parser/program_params.h>
+#include <solver/metaheuristics/visited_tours.h>
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
 #include <utility>
 #include <vector>
 
+class kopt3_solver;
+class progress_sink;
+class tabu_list;
+
 class tabu_solver {
 public:
-    tabu_solver(tsp_graph& g, const program_params& params, program_data& data, std::vector<path> initial_solutions);
+    // The searches start from the tours in the solution pool, and publish their results to it
+    tabu_solver(tsp_graph& g, const program_params& params, program_data& data, elite_pool& solution_pool);
+    
+    // Runs a tabu search from each initial solution, max_parallel_searches at a time, until the
+    // time limit, the target cost or a cancellation stops them
     std::vector<path> solve();
-    std::vector<path> solve_sequential();
     void solve_parameter_tuning();
+    
+    // Can be called from another thread: running searches return their best tour so far
+    void cancel() { cancelled = true; }
 
     struct tabu_move {
         std::pair<int,int> vertices;
@@ -34,7 +50,7 @@ public:
         path p;
         tabu_move shortest_erased_edge;
 
-        tabu_result(path p, tabu_move shortest_erased_edge) : p{p}, shortest_erased_edge{shortest_erased_edge} {}
+        tabu_result(path p, tabu_move shortest_erased_edge) : p{std::move(p)}, shortest_erased_edge{shortest_erased_edge} {}
         inline bool empty() { return p.path_v.empty(); }
     };
 
@@ -42,21 +58,42 @@ public:
         tabu_result overall_best;
         tabu_result best_without_tabu;
 
-        tabu_and_non_tabu_solutions(tabu_result overall_best, tabu_result best_without_tabu) : overall_best{overall_best}, best_without_tabu{best_without_tabu} {}
+        tabu_and_non_tabu_solutions(tabu_result overall_best, tabu_result best_without_tabu) : overall_best{std::move(overall_best)}, best_without_tabu{std::move(best_without_tabu)} {}
     };
     
 private:    
     tsp_graph&              g;
     const program_params&   params;
     program_data&           data;
-    std::vector<path>       initial_solutions;
-    std::vector<path>       sliced_initial_solutions;
+    elite_pool&             solution_pool;
+    std::vector<tour_ptr>   initial_solutions;
     int                     tabu_list_size;
+    std::atomic<bool>       cancelled;
+    std::atomic<bool>       target_reached;
+    
+    // Set from tabu_search.time_limit by each call of solve()
+    std::chrono::high_resolution_clock::time_point deadline;
+    
+    // Tours in which the variable neighbourhood descent found no improving move, shared by the
+    // searches and the relinking workers: a descent reaching one of them stops without scanning
+    // its neighbourhoods again
+    mutable visited_tours   local_optima;
+    mutable std::mutex      local_optima_mutex;
     
     static constexpr double eps = 0.0001;
 
-    path tabu_search(path init_sol);
-    void update_tabu_list(std::vector<tabu_move>& tabu_list, const tabu_solver::tabu_result& sol);
+    // Random segment swaps applied to an elite tour before restarting a search from it
+    static constexpr int perturbation_moves = 3;
+    static constexpr int max_perturbation_attempts = 100;
+    
+    bool must_stop() const { return cancelled || target_reached || std::chrono::high_resolution_clock::now() >= deadline; }
+    
+    path tabu_search(path init_sol, elite_pool& elite, progress_sink& progress, int search_id);
+    path perturb(path p, std::mt19937& gen) const;
+    path variable_neighbourhood_descent(path p, kopt3_solver& kopt3solv) const;
+    
+    // Relinks every ordered pair of the given tours, returning the tours better than both ends
+    std::vector<path> path_relinking(const std::vector<tour_ptr>& elite_solutions) const;
     void print_results(const std::vector<path>& solutions) const;
 };
 
@@ -0,0 +1,20 @@
+#include <solver/metaheuristics/visited_tours.h>
+
+bool visited_tours::insert(const path& p) {
+    if(max_size <= 0) {
+        return true;
+    }
+    
+    if(!hashes.insert(p.hash).second) {
+        return false;
+    }
+    
+    insertion_order.push_back(p.hash);
+    
+    if((int)insertion_order.size() > max_size) {
+        hashes.erase(insertion_order.front());
+        insertion_order.pop_front();
+    }
+    
+    return true;
+}
\ No newline at end of file
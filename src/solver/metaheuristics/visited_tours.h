@@ -0,0 +1,26 @@
+#ifndef VISITED_TOURS_H
+#define VISITED_TOURS_H
+
+#include <network/path.h>
+
+#include <cstdint>
+#include <deque>
+#include <unordered_set>
+
+// Hashes of the last max_size tours inserted: when the memory is full, the oldest one is forgotten.
+// With max_size 0 nothing is remembered
+class visited_tours {
+    int                                 max_size;
+    std::unordered_set<std::uint64_t>   hashes;
+    std::deque<std::uint64_t>           insertion_order;
+
+public:
+    visited_tours(int max_size) : max_size{max_size} {}
+    
+    bool contains(const path& p) const { return hashes.count(p.hash) > 0u; }
+    
+    // Returns false if the tour is already there
+    bool insert(const path& p);
+};
+
+#endif
\ No newline at end of file